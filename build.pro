@@ -38,9 +38,12 @@
 TEMPLATE = subdirs
 
 CONFIG += ordered
-SUBDIRS = librssguard rssguard
+SUBDIRS = librssguard rssguard tests
 
 librssguard.subdir  = src/librssguard
 
 rssguard.subdir  = src/rssguard
 rssguard.depends = libtextosaurus
+
+tests.subdir  = tests
+tests.depends = librssguard
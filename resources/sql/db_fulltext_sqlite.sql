@@ -0,0 +1,16 @@
+CREATE VIRTUAL TABLE IF NOT EXISTS MessagesFullText USING fts5(title, author, contents, content = 'Messages', content_rowid = 'id');
+-- !
+INSERT INTO MessagesFullText (MessagesFullText) VALUES ('rebuild');
+-- !
+CREATE TRIGGER IF NOT EXISTS trg_Messages_fulltext_insert AFTER INSERT ON Messages BEGIN
+  INSERT INTO MessagesFullText (rowid, title, author, contents) VALUES (new.id, new.title, new.author, new.contents);
+END;
+-- !
+CREATE TRIGGER IF NOT EXISTS trg_Messages_fulltext_delete AFTER DELETE ON Messages BEGIN
+  INSERT INTO MessagesFullText (MessagesFullText, rowid, title, author, contents) VALUES ('delete', old.id, old.title, old.author, old.contents);
+END;
+-- !
+CREATE TRIGGER IF NOT EXISTS trg_Messages_fulltext_update AFTER UPDATE OF title, author, contents ON Messages BEGIN
+  INSERT INTO MessagesFullText (MessagesFullText, rowid, title, author, contents) VALUES ('delete', old.id, old.title, old.author, old.contents);
+  INSERT INTO MessagesFullText (rowid, title, author, contents) VALUES (new.id, new.title, new.author, new.contents);
+END;
\ No newline at end of file
@@ -12,7 +12,7 @@ CREATE TABLE IF NOT EXISTS Information (
   inf_value       TEXT        NOT NULL
 );
 -- !
-INSERT INTO Information VALUES (1, 'schema_version', '15');
+INSERT INTO Information VALUES (1, 'schema_version', '22');
 -- !
 CREATE TABLE IF NOT EXISTS Accounts (
   id              INTEGER     PRIMARY KEY,
@@ -41,6 +41,7 @@ CREATE TABLE IF NOT EXISTS OwnCloudAccounts (
   force_update    INTEGER(1)  NOT NULL DEFAULT 0 CHECK (force_update >= 0 AND force_update <= 1),
   msg_limit       INTEGER     NOT NULL DEFAULT -1 CHECK (msg_limit >= -1),
   update_only_unread    INTEGER(1)  NOT NULL DEFAULT 0 CHECK (update_only_unread >= 0 AND update_only_unread <= 1),
+  last_modified   BIGINT      NOT NULL DEFAULT 0,
   
   FOREIGN KEY (id) REFERENCES Accounts (id)
 );
@@ -53,6 +54,7 @@ CREATE TABLE IF NOT EXISTS InoreaderAccounts (
   redirect_url    TEXT,
   refresh_token   TEXT,
   msg_limit       INTEGER     NOT NULL DEFAULT -1 CHECK (msg_limit >= -1),
+  last_sync       BIGINT      NOT NULL DEFAULT 0,
   
   FOREIGN KEY (id) REFERENCES Accounts (id)
 );
@@ -103,6 +105,9 @@ CREATE TABLE IF NOT EXISTS Feeds (
   type            INTEGER,
   account_id      INTEGER       NOT NULL,
   custom_id       TEXT,
+  http_etag       TEXT,
+  http_last_modified TEXT,
+  contents_hash   BIGINT        NOT NULL DEFAULT 0,
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
@@ -129,6 +134,22 @@ CREATE TABLE IF NOT EXISTS Messages (
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
 -- !
+CREATE INDEX idx_Messages_feed_state ON Messages (account_id, feed(64), is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX idx_Messages_account_state ON Messages (account_id, is_deleted, is_pdeleted, is_read, feed(64));
+-- !
+CREATE INDEX idx_Messages_important_state ON Messages (account_id, is_important, is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX idx_Messages_custom_id ON Messages (account_id, custom_id(100));
+-- !
+CREATE INDEX idx_Messages_feed_url ON Messages (feed(64), account_id, url(190));
+-- !
+CREATE INDEX idx_Messages_account_url ON Messages (account_id, url(190));
+-- !
+CREATE INDEX idx_Messages_account_title ON Messages (account_id, title(190));
+-- !
+CREATE FULLTEXT INDEX idx_Messages_fulltext ON Messages (title, author, contents);
+-- !
 CREATE TABLE IF NOT EXISTS MessageFilters (
   id                  INTEGER     PRIMARY KEY,
   name                TEXT        NOT NULL CHECK (name != ''),
@@ -144,4 +165,4 @@ CREATE TABLE IF NOT EXISTS MessageFiltersInFeeds (
   FOREIGN KEY (account_id) REFERENCES Accounts (id) ON DELETE CASCADE
 );
 -- !
-UPDATE Information SET inf_value = '15' WHERE inf_key = 'schema_version';
\ No newline at end of file
+UPDATE Information SET inf_value = '22' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -6,7 +6,7 @@ CREATE TABLE IF NOT EXISTS Information (
   inf_value       TEXT        NOT NULL
 );
 -- !
-INSERT INTO Information VALUES (1, 'schema_version', '15');
+INSERT INTO Information VALUES (1, 'schema_version', '22');
 -- !
 CREATE TABLE IF NOT EXISTS Accounts (
   id              INTEGER     PRIMARY KEY,
@@ -35,6 +35,7 @@ CREATE TABLE IF NOT EXISTS OwnCloudAccounts (
   force_update        INTEGER(1)  NOT NULL CHECK (force_update >= 0 AND force_update <= 1) DEFAULT 0,
   msg_limit           INTEGER     NOT NULL DEFAULT -1 CHECK (msg_limit >= -1),
   update_only_unread  INTEGER(1)  NOT NULL CHECK (update_only_unread >= 0 AND update_only_unread <= 1) DEFAULT 0,
+  last_modified       INTEGER     NOT NULL DEFAULT 0,
   
   FOREIGN KEY (id) REFERENCES Accounts (id)
 );
@@ -47,6 +48,7 @@ CREATE TABLE IF NOT EXISTS InoreaderAccounts (
   redirect_url    TEXT,
   refresh_token   TEXT,
   msg_limit       INTEGER     NOT NULL DEFAULT -1 CHECK (msg_limit >= -1),
+  last_sync       INTEGER     NOT NULL DEFAULT 0,
   
   FOREIGN KEY (id) REFERENCES Accounts (id)
 );
@@ -97,6 +99,9 @@ CREATE TABLE IF NOT EXISTS Feeds (
   type            INTEGER,
   account_id      INTEGER     NOT NULL,
   custom_id       TEXT,
+  http_etag       TEXT,
+  http_last_modified TEXT,
+  contents_hash   INTEGER     NOT NULL DEFAULT 0,
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
@@ -123,6 +128,20 @@ CREATE TABLE IF NOT EXISTS Messages (
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
 -- !
+CREATE INDEX IF NOT EXISTS idx_Messages_feed_state ON Messages (account_id, feed, is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_account_state ON Messages (account_id, is_deleted, is_pdeleted, is_read, feed);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_important_state ON Messages (account_id, is_important, is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_custom_id ON Messages (account_id, custom_id);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_feed_url ON Messages (feed, account_id, url);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_account_url ON Messages (account_id, url);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_account_title ON Messages (account_id, title);
+-- !
 CREATE TABLE IF NOT EXISTS MessageFilters (
   id                  INTEGER     PRIMARY KEY,
   name                TEXT        NOT NULL CHECK (name != ''),
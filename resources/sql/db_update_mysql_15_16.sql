@@ -0,0 +1,11 @@
+CREATE INDEX idx_Messages_feed_state ON Messages (account_id, feed(64), is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX idx_Messages_account_state ON Messages (account_id, is_deleted, is_pdeleted, is_read, feed(64));
+-- !
+CREATE INDEX idx_Messages_important_state ON Messages (account_id, is_important, is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX idx_Messages_custom_id ON Messages (account_id, custom_id(100));
+-- !
+CREATE INDEX idx_Messages_feed_url ON Messages (feed(64), account_id, url(190));
+-- !
+UPDATE Information SET inf_value = '16' WHERE inf_key = 'schema_version';
\ No newline at end of file
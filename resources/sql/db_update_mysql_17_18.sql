@@ -0,0 +1,3 @@
+CREATE FULLTEXT INDEX idx_Messages_fulltext ON Messages (title, author, contents);
+-- !
+UPDATE Information SET inf_value = '18' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,5 @@
+CREATE INDEX idx_Messages_account_url ON Messages (account_id, url(190));
+-- !
+CREATE INDEX idx_Messages_account_title ON Messages (account_id, title(190));
+-- !
+UPDATE Information SET inf_value = '19' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,4 @@
+ALTER TABLE Feeds
+ADD COLUMN contents_hash BIGINT NOT NULL DEFAULT 0;
+-- !
+UPDATE Information SET inf_value = '22' WHERE inf_key = 'schema_version';
\ No newline at end of file
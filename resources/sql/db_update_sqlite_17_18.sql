@@ -0,0 +1 @@
+UPDATE Information SET inf_value = '18' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,5 @@
+CREATE INDEX IF NOT EXISTS idx_Messages_account_url ON Messages (account_id, url);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_account_title ON Messages (account_id, title);
+-- !
+UPDATE Information SET inf_value = '19' WHERE inf_key = 'schema_version';
\ No newline at end of file
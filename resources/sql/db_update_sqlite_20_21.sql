@@ -0,0 +1,3 @@
+ALTER TABLE InoreaderAccounts ADD COLUMN last_sync INTEGER NOT NULL DEFAULT 0;
+-- !
+UPDATE Information SET inf_value = '21' WHERE inf_key = 'schema_version';
\ No newline at end of file
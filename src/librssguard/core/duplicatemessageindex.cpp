@@ -0,0 +1,118 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "core/duplicatemessageindex.h"
+
+#include "miscellaneous/application.h"
+#include "miscellaneous/databasefactory.h"
+
+#include <QElapsedTimer>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+
+bool DuplicateMessageIndex::mayBeDuplicate(const QSqlDatabase& db, int account_id, DuplicationAttributeCheck attributes,
+                                           const QString& title, const QString& url, const QString& author,
+                                           qint64 date_created, const QString& feed_custom_id) {
+  if (!isUsable()) {
+    return true;
+  }
+
+  QMutexLocker locker(&m_mutex);
+  QHash<int, QSet<uint>>& account_indexes = m_indexes[account_id];
+  auto index = account_indexes.constFind(int(attributes));
+
+  if (index == account_indexes.constEnd()) {
+    QSet<uint> new_index;
+
+    if (!buildIndex(db, account_id, attributes, new_index)) {
+      return true;
+    }
+
+    index = account_indexes.insert(int(attributes), new_index);
+  }
+
+  return index->contains(fingerprint(attributes, title, url, author, date_created, feed_custom_id));
+}
+
+void DuplicateMessageIndex::addMessages(int account_id, const QList<Message>& messages) {
+  QMutexLocker locker(&m_mutex);
+  auto account_indexes = m_indexes.find(account_id);
+
+  if (account_indexes == m_indexes.end()) {
+    // Nothing is indexed for this account yet.
+    return;
+  }
+
+  for (auto index = account_indexes->begin(); index != account_indexes->end(); index++) {
+    const DuplicationAttributeCheck attributes = static_cast<DuplicationAttributeCheck>(index.key());
+
+    for (const Message& message : messages) {
+      index->insert(fingerprint(attributes, message.m_title, message.m_url, message.m_author,
+                                message.m_created.toMSecsSinceEpoch(), message.m_feedId));
+    }
+  }
+}
+
+void DuplicateMessageIndex::removeAccount(int account_id) {
+  QMutexLocker locker(&m_mutex);
+
+  m_indexes.remove(account_id);
+}
+
+bool DuplicateMessageIndex::isUsable() const {
+  // NOTE: MySQL compares texts using case-insensitive collations,
+  // so our exact fingerprints cannot tell that there is no duplicate there.
+  return qApp->database()->activeDatabaseDriver() != DatabaseFactory::UsedDriver::MYSQL;
+}
+
+bool DuplicateMessageIndex::buildIndex(const QSqlDatabase& db, int account_id,
+                                       DuplicationAttributeCheck attributes, QSet<uint>& index) const {
+  QElapsedTimer tmr;
+  QSqlQuery q(db);
+
+  tmr.start();
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT title, url, author, date_created, feed FROM Messages WHERE account_id = :account_id;"));
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec()) {
+    qWarning("Failed to build index of messages for duplicate checks: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  while (q.next()) {
+    index.insert(fingerprint(attributes, q.value(0).toString(), q.value(1).toString(), q.value(2).toString(),
+                             q.value(3).value<qint64>(), q.value(4).toString()));
+  }
+
+  qDebug("Built index of %d messages for duplicate checks of account '%d' in %lld ms.",
+         index.size(), account_id, tmr.elapsed());
+  return true;
+}
+
+uint DuplicateMessageIndex::fingerprint(DuplicationAttributeCheck attributes, const QString& title, const QString& url,
+                                        const QString& author, qint64 date_created, const QString& feed_custom_id) {
+  uint hash = 0;
+
+  if ((attributes& DuplicationAttributeCheck::SameTitle) == DuplicationAttributeCheck::SameTitle) {
+    hash = qHash(title, hash);
+  }
+
+  if ((attributes& DuplicationAttributeCheck::SameUrl) == DuplicationAttributeCheck::SameUrl) {
+    hash = qHash(url, hash);
+  }
+
+  if ((attributes& DuplicationAttributeCheck::SameAuthor) == DuplicationAttributeCheck::SameAuthor) {
+    hash = qHash(author, hash);
+  }
+
+  if ((attributes& DuplicationAttributeCheck::SameDateCreated) == DuplicationAttributeCheck::SameDateCreated) {
+    hash = qHash(date_created, hash);
+  }
+
+  if ((attributes& DuplicationAttributeCheck::AllFeedsSameAccount) != DuplicationAttributeCheck::AllFeedsSameAccount) {
+    hash = qHash(feed_custom_id, hash);
+  }
+
+  return hash;
+}
@@ -0,0 +1,50 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef DUPLICATEMESSAGEINDEX_H
+#define DUPLICATEMESSAGEINDEX_H
+
+#include "core/message.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
+class QSqlDatabase;
+
+// In-memory index of messages stored in DB, used when filters check for duplicate messages.
+//
+// For each account and each combination of DuplicationAttributeCheck flags, there
+// is a set of fingerprints of all messages of that account. Sets are built lazily when
+// first needed and then kept up-to-date as new messages are stored.
+//
+// NOTE: Fingerprints may collide and messages might be deleted from DB since,
+// so positive answer from the index must be always confirmed via DB.
+class DuplicateMessageIndex {
+  public:
+    explicit DuplicateMessageIndex() = default;
+
+    // Returns false if there is surely no duplicate of given message in DB,
+    // true if there might be one.
+    bool mayBeDuplicate(const QSqlDatabase& db, int account_id, DuplicationAttributeCheck attributes,
+                        const QString& title, const QString& url, const QString& author,
+                        qint64 date_created, const QString& feed_custom_id);
+
+    // Adds messages, which were just inserted to DB or updated in DB, to existing indexes.
+    void addMessages(int account_id, const QList<Message>& messages);
+    void removeAccount(int account_id);
+
+  private:
+    bool isUsable() const;
+    bool buildIndex(const QSqlDatabase& db, int account_id, DuplicationAttributeCheck attributes, QSet<uint>& index) const;
+
+    static uint fingerprint(DuplicationAttributeCheck attributes, const QString& title, const QString& url,
+                            const QString& author, qint64 date_created, const QString& feed_custom_id);
+
+  private:
+    QMutex m_mutex;
+
+    // Keys are account IDs and combinations of DuplicationAttributeCheck flags.
+    QHash<int, QHash<int, QSet<uint>>> m_indexes;
+};
+
+#endif // DUPLICATEMESSAGEINDEX_H
@@ -3,51 +3,210 @@
 #include "core/feeddownloader.h"
 
 #include "core/messagefilter.h"
+#include "core/messagesanitizer.h"
 #include "definitions/definitions.h"
 #include "exceptions/filteringexception.h"
 #include "miscellaneous/application.h"
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/feed.h"
+#include "services/abstract/serviceroot.h"
+#include "services/abstract/syncforserviceroot.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QJSEngine>
 #include <QMutexLocker>
-#include <QRegularExpression>
+#include <QRunnable>
 #include <QString>
 #include <QThread>
+#include <QThreadPool>
 #include <QUrl>
 
+// Downloads and parses messages of single feed. Runs in thread pool.
+class FeedDownloadTask : public QRunnable {
+  public:
+    explicit FeedDownloadTask(FeedDownloader* downloader, Feed* feed, const QString& lane)
+      : m_downloader(downloader), m_feed(feed), m_lane(lane) {}
+
+    void run() {
+      qDebug().nospace() << "Downloading new messages for feed ID "
+                         << m_feed->customId() << " URL: " << m_feed->url() << " title: " << m_feed->title() << " in thread: \'"
+                         << QThread::currentThreadId() << "\'.";
+
+      DownloadedFeed downloaded_feed;
+      QElapsedTimer tmr; tmr.start();
+
+      downloaded_feed.m_feed = m_feed;
+      downloaded_feed.m_lane = m_lane;
+      downloaded_feed.m_errorDuringObtaining = false;
+      downloaded_feed.m_messages = m_feed->obtainNewMessages(&downloaded_feed.m_errorDuringObtaining);
+      downloaded_feed.m_dataChange = m_feed->lastDataChange();
+
+      qDebug().nospace() << "Downloaded " << downloaded_feed.m_messages.size() << " messages for feed ID "
+                         << m_feed->customId() << " URL: " << m_feed->url() << " title: " << m_feed->title() << " in thread: \'"
+                         << QThread::currentThreadId() << "\'. Operation took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
+
+      // Now, sanitize messages (tweak encoding etc.).
+      for (auto& msg : downloaded_feed.m_messages) {
+        MessageSanitizer::sanitizeMessage(msg);
+      }
+
+      m_downloader->feedDownloaded(downloaded_feed);
+    }
+
+  private:
+    FeedDownloader* m_downloader;
+    Feed* m_feed;
+    QString m_lane;
+};
+
+// Sends cached changes of single account to server. Runs in thread pool.
+class CacheFlushTask : public QRunnable {
+  public:
+    explicit CacheFlushTask(CacheForServiceRoot* cache) : m_cache(cache) {}
+
+    void run() {
+      m_cache->saveAllCachedData(false);
+    }
+
+  private:
+    CacheForServiceRoot* m_cache;
+};
+
 FeedDownloader::FeedDownloader()
-  : QObject(), m_mutex(new QMutex()), m_feedsUpdated(0), m_feedsOriginalCount(0) {
+  : QObject(), m_mutex(new QMutex()), m_pipelineMutex(new QMutex()), m_downloadPool(new QThreadPool(this)),
+  m_downloadsRunning(0), m_maxParallelDownloads(FEED_DOWNLOADER_MAX_THREADS),
+  m_maxParallelDownloadsPerHost(FEED_DOWNLOADER_MAX_HOST_THREADS), m_feedsUpdated(0), m_feedsOriginalCount(0),
+  m_filterEngine(nullptr), m_filterMessageObject(nullptr) {
   qRegisterMetaType<FeedDownloadResults>("FeedDownloadResults");
 }
 
 FeedDownloader::~FeedDownloader() {
+  m_downloadPool->waitForDone();
+  clearFilterEngine();
   m_mutex->tryLock();
   m_mutex->unlock();
   delete m_mutex;
+  delete m_pipelineMutex;
   qDebug("Destroying FeedDownloader instance.");
 }
 
 bool FeedDownloader::isUpdateRunning() const {
-  return !m_feeds.isEmpty();
+  QMutexLocker locker(m_pipelineMutex);
+
+  return !m_feeds.isEmpty() || m_downloadsRunning > 0 || !m_downloadedFeeds.isEmpty();
 }
 
 void FeedDownloader::updateAvailableFeeds() {
+  QList<CacheForServiceRoot*> caches;
+  QHash<ServiceRoot*, QStringList> synced_feeds;
+
   for (const Feed* feed : m_feeds) {
     auto* cache = dynamic_cast<CacheForServiceRoot*>(feed->getParentServiceRoot());
 
-    if (cache != nullptr) {
-      qDebug("Saving cache for feed with DB ID %d and title '%s'.", feed->id(), qPrintable(feed->title()));
-      cache->saveAllCachedData(false);
+    if (cache != nullptr && !caches.contains(cache)) {
+      caches.append(cache);
+    }
+
+    if (dynamic_cast<SyncForServiceRoot*>(feed->getParentServiceRoot()) != nullptr) {
+      synced_feeds[feed->getParentServiceRoot()].append(feed->customId());
+    }
+  }
+
+  // Accounts which download messages of all feeds at once
+  // must know which feeds are updated now.
+  for (auto i = synced_feeds.constBegin(); i != synced_feeds.constEnd(); i++) {
+    QStringList account_feeds;
+
+    for (const Feed* account_feed : i.key()->getSubTreeFeeds()) {
+      account_feeds.append(account_feed->customId());
+    }
+
+    dynamic_cast<SyncForServiceRoot*>(i.key())->startSync(i.value(), account_feeds);
+  }
+
+  m_maxParallelDownloads = qMax(1, qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateConcurrency)).toInt());
+  m_maxParallelDownloadsPerHost = qMax(1, qApp->settings()->value(GROUP(Feeds),
+                                                                  SETTING(Feeds::UpdateConcurrencyPerHost)).toInt());
+  m_downloadPool->setMaxThreadCount(m_maxParallelDownloads);
+
+  // Cached changes of each account are sent only once and
+  // accounts do not share network access, so they are sent concurrently.
+  qDebug("Saving cached changes of %d accounts.", caches.size());
+
+  for (CacheForServiceRoot* cache : caches) {
+    m_downloadPool->start(new CacheFlushTask(cache));
+  }
+
+  m_downloadPool->waitForDone();
+
+  QMutexLocker locker(m_pipelineMutex);
+
+  startPendingDownloads();
+
+  while (!m_feeds.isEmpty() || m_downloadsRunning > 0 || !m_downloadedFeeds.isEmpty()) {
+    while (m_downloadedFeeds.isEmpty()) {
+      m_pipelineCondition.wait(m_pipelineMutex);
     }
+
+    DownloadedFeed downloaded_feed = m_downloadedFeeds.takeFirst();
+
+    // Messages are stored in DB without holding the lock so
+    // that workers can hand over next downloaded feeds meanwhile.
+    locker.unlock();
+    storeMessages(downloaded_feed);
+    locker.relock();
+  }
+}
+
+void FeedDownloader::feedDownloaded(const DownloadedFeed& downloaded_feed) {
+  QMutexLocker locker(m_pipelineMutex);
+
+  m_downloadsRunning--;
+
+  if (--m_activeLanes[downloaded_feed.m_lane] <= 0) {
+    m_activeLanes.remove(downloaded_feed.m_lane);
   }
 
-  while (!m_feeds.isEmpty()) {
-    updateOneFeed(m_feeds.takeFirst());
+  m_downloadedFeeds.append(downloaded_feed);
+  startPendingDownloads();
+  m_pipelineCondition.wakeAll();
+}
+
+void FeedDownloader::startPendingDownloads() {
+  for (int i = 0; i < m_feeds.size() && m_downloadsRunning < m_maxParallelDownloads; i++) {
+    Feed* feed = m_feeds.at(i);
+    const QString lane = downloadLane(feed);
+
+    if (m_activeLanes.value(lane) >= downloadLaneLimit(feed)) {
+      // This host (or account) is busy, try next feed.
+      continue;
+    }
+
+    m_feeds.removeAt(i--);
+    m_activeLanes[lane]++;
+    m_downloadsRunning++;
+    m_downloadPool->start(new FeedDownloadTask(this, feed, lane));
   }
 }
 
+QString FeedDownloader::downloadLane(const Feed* feed) const {
+  const ServiceRoot* root = feed->getParentServiceRoot();
+
+  if (root->supportsConcurrentFeedUpdates()) {
+    // Each feed has its own endpoint, feeds are grouped by their host.
+    return QSL("host:") + QUrl(feed->url()).host().toLower();
+  }
+  else {
+    // Feeds share single network session of their account.
+    return QSL("account:") + QString::number(root->accountId());
+  }
+}
+
+int FeedDownloader::downloadLaneLimit(const Feed* feed) const {
+  return feed->getParentServiceRoot()->supportsConcurrentFeedUpdates() ? m_maxParallelDownloadsPerHost : 1;
+}
+
 void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
   QMutexLocker locker(m_mutex);
 
@@ -56,10 +215,12 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
   }
   else {
     qDebug().nospace() << "Starting feed updates from worker in thread: \'" << QThread::currentThreadId() << "\'.";
+    m_pipelineMutex->lock();
     m_feeds = feeds;
     m_feedsOriginalCount = m_feeds.size();
     m_results.clear();
     m_feedsUpdated = 0;
+    m_pipelineMutex->unlock();
 
     // Job starts now.
     emit updateStarted();
@@ -71,58 +232,40 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
 }
 
 void FeedDownloader::stopRunningUpdate() {
+  QMutexLocker locker(m_pipelineMutex);
+
+  // Feeds which are already being downloaded are finished normally.
   m_feeds.clear();
   m_feedsOriginalCount = m_feedsUpdated = 0;
 }
 
-void FeedDownloader::updateOneFeed(Feed* feed) {
-  qDebug().nospace() << "Downloading new messages for feed ID "
-                     << feed->customId() << " URL: " << feed->url() << " title: " << feed->title() << " in thread: \'"
-                     << QThread::currentThreadId() << "\'.";
-
-  bool error_during_obtaining = false;
-  QElapsedTimer tmr; tmr.start();
-  QList<Message> msgs = feed->obtainNewMessages(&error_during_obtaining);
-
-  qDebug().nospace() << "Downloaded " << msgs.size() << " messages for feed ID "
-                     << feed->customId() << " URL: " << feed->url() << " title: " << feed->title() << " in thread: \'"
-                     << QThread::currentThreadId() << "\'. Operation took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
-
-  // Now, sanitize messages (tweak encoding etc.).
-  for (auto& msg : msgs) {
-    // Also, make sure that HTML encoding, encoding of special characters, etc., is fixed.
-    msg.m_contents = QUrl::fromPercentEncoding(msg.m_contents.toUtf8());
-    msg.m_author = msg.m_author.toUtf8();
+void FeedDownloader::storeMessages(DownloadedFeed& downloaded_feed) {
+  Feed* feed = downloaded_feed.m_feed;
+  QList<Message>& msgs = downloaded_feed.m_messages;
+  QElapsedTimer tmr;
 
-    // Sanitize title. Remove newlines etc.
-    msg.m_title = QUrl::fromPercentEncoding(msg.m_title.toUtf8())
+  if (downloaded_feed.m_dataChange != Feed::DataChange::Changed) {
+    // Feed did not change since its last update, there is nothing to filter or store.
+    if (downloaded_feed.m_dataChange == Feed::DataChange::NotModified) {
+      m_results.appendNotModifiedFeed(feed->title());
+    }
+    else {
+      m_results.appendUnchangedFeed(feed->title());
+    }
 
-                  // Replace all continuous white space.
-                  .replace(QRegularExpression(QSL("[\\s]{2,}")), QSL(" "))
+    feed->setStatus(Feed::Normal);
+    feed->getParentServiceRoot()->itemChanged(QList<RootItem*>() << feed);
 
-                  // Remove all newlines and leading white space.
-                  .remove(QRegularExpression(QSL("([\\n\\r])|(^\\s)")));
+    qDebug("Feed %s was not modified.", qPrintable(feed->customId()));
+    reportFeedProgress(feed);
+    return;
   }
 
   if (!feed->messageFilters().isEmpty()) {
-    tmr.restart();
-
-    bool is_main_thread = QThread::currentThread() == qApp->thread();
-    QSqlDatabase database = is_main_thread ?
-                            qApp->database()->connection(metaObject()->className()) :
-                            qApp->database()->connection(QSL("feed_upd"));
+    tmr.start();
 
     // Perform per-message filtering.
-    QJSEngine filter_engine;
-
-    // Create JavaScript communication wrapper for the message.
-    MessageObject msg_obj(&database, feed->customId(), feed->getParentServiceRoot()->accountId());
-
-    // Register the wrapper.
-    auto js_object = filter_engine.newQObject(&msg_obj);
-
-    filter_engine.installExtensions(QJSEngine::Extension::ConsoleExtension);
-    filter_engine.globalObject().setProperty("msg", js_object);
+    prepareFilterEngine(feed);
 
     qDebug().nospace() << "Setting up JS evaluation took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
 
@@ -130,7 +273,7 @@ void FeedDownloader::updateOneFeed(Feed* feed) {
       tmr.restart();
 
       // Attach live message object to wrapper.
-      msg_obj.setMessage(&msgs[i]);
+      m_filterMessageObject->setMessage(&msgs[i]);
       qDebug().nospace() << "Hooking message took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
 
       auto feed_filters = feed->messageFilters();
@@ -146,12 +289,18 @@ void FeedDownloader::updateOneFeed(Feed* feed) {
 
         MessageFilter* msg_filter = filter.data();
 
+        if (!m_compiledFilters.contains(msg_filter->id())) {
+          m_compiledFilters.insert(msg_filter->id(), msg_filter->compileFilter(m_filterEngine));
+        }
+
         tmr.restart();
 
         try {
-          FilteringAction decision = msg_filter->filterMessage(&filter_engine);
+          FilteringAction decision = MessageFilter::runFilter(m_compiledFilters.value(msg_filter->id()));
+          const qint64 filter_time = tmr.nsecsElapsed() / 1000;
 
-          qDebug().nospace() << "Running filter script, it took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
+          m_results.appendFilterTiming(msg_filter->name(), filter_time);
+          qDebug().nospace() << "Running filter script, it took " << filter_time << " microseconds.";
 
           switch (decision) {
             case FilteringAction::Accept:
@@ -178,14 +327,12 @@ void FeedDownloader::updateOneFeed(Feed* feed) {
     }
   }
 
-  m_feedsUpdated++;
-
   // Now make sure, that messages are actually stored to SQL in a locked state.
   qDebug().nospace() << "Saving messages of feed ID "
                      << feed->customId() << " URL: " << feed->url() << " title: " << feed->title() << " in thread: \'"
                      << QThread::currentThreadId() << "\'.";
 
-  int updated_messages = feed->updateMessages(msgs, error_during_obtaining);
+  int updated_messages = feed->updateMessages(msgs, downloaded_feed.m_errorDuringObtaining);
 
   qDebug("%d messages for feed %s stored in DB.", updated_messages, qPrintable(feed->customId()));
 
@@ -193,12 +340,75 @@ void FeedDownloader::updateOneFeed(Feed* feed) {
     m_results.appendUpdatedFeed(QPair<QString, int>(feed->title(), updated_messages));
   }
 
-  qDebug("Made progress in feed updates, total feeds count %d/%d (id of feed is %d).", m_feedsUpdated, m_feedsOriginalCount, feed->id());
-  emit updateProgress(feed, m_feedsUpdated, m_feedsOriginalCount);
+  reportFeedProgress(feed);
+}
+
+void FeedDownloader::reportFeedProgress(Feed* feed) {
+  QMutexLocker locker(m_pipelineMutex);
+
+  if (m_feedsOriginalCount <= 0) {
+    // Update was stopped, feeds which were already downloaded
+    // are still stored, but they do not make any progress.
+    return;
+  }
+
+  const int feeds_updated = ++m_feedsUpdated;
+  const int feeds_count = m_feedsOriginalCount;
+
+  locker.unlock();
+
+  qDebug("Made progress in feed updates, total feeds count %d/%d (id of feed is %d).", feeds_updated, feeds_count, feed->id());
+  emit updateProgress(feed, feeds_updated, feeds_count);
+}
+
+void FeedDownloader::prepareFilterEngine(Feed* feed) {
+  if (m_filterEngine == nullptr) {
+    bool is_main_thread = QThread::currentThread() == qApp->thread();
+
+    m_filterDatabase = is_main_thread ?
+                       qApp->database()->connection(metaObject()->className()) :
+                       qApp->database()->connection(QSL("feed_upd"));
+    m_filterEngine = new QJSEngine();
+
+    // Create JavaScript communication wrapper for the message.
+    // NOTE: Wrapper is owned by the engine, so it is not garbage-collected.
+    m_filterMessageObject = new MessageObject(&m_filterDatabase, QString(), 0, m_filterEngine);
+
+    // Register the wrapper.
+    m_filterEngine->installExtensions(QJSEngine::Extension::ConsoleExtension);
+    m_filterEngine->globalObject().setProperty("msg", m_filterEngine->newQObject(m_filterMessageObject));
+  }
+
+  m_filterMessageObject->setFeedCustomId(feed->customId());
+  m_filterMessageObject->setAccountId(feed->getParentServiceRoot()->accountId());
+}
+
+void FeedDownloader::clearFilterEngine() {
+  // NOTE: Compiled filters belong to the engine, they must be released first.
+  m_compiledFilters.clear();
+
+  if (m_filterEngine != nullptr) {
+    delete m_filterEngine;
+
+    m_filterEngine = nullptr;
+    m_filterMessageObject = nullptr;
+  }
 }
 
 void FeedDownloader::finalizeUpdate() {
-  qDebug().nospace() << "Finished feed updates in thread: \'" << QThread::currentThreadId() << "\'.";
+  qDebug().nospace() << "Finished feed updates in thread: \'" << QThread::currentThreadId() << "\', "
+                     << m_results.notModifiedFeeds().size() << " feeds were not modified, "
+                     << m_results.unchangedFeeds().size() << " feeds had unchanged data.";
+
+  const QHash<QString, QPair<int, qint64>> filter_timings = m_results.filterTimings();
+
+  for (auto i = filter_timings.constBegin(); i != filter_timings.constEnd(); i++) {
+    qDebug().nospace() << "Message filter '" << i.key() << "' processed " << i.value().first
+                       << " messages in " << i.value().second << " microseconds.";
+  }
+
+  // Filters could be changed before next update, so they will be compiled again.
+  clearFilterEngine();
   m_results.sort();
 
   // Update of feeds has finished.
@@ -228,6 +438,21 @@ void FeedDownloadResults::appendUpdatedFeed(const QPair<QString, int>& feed) {
   m_updatedFeeds.append(feed);
 }
 
+void FeedDownloadResults::appendNotModifiedFeed(const QString& feed_title) {
+  m_notModifiedFeeds.append(feed_title);
+}
+
+void FeedDownloadResults::appendUnchangedFeed(const QString& feed_title) {
+  m_unchangedFeeds.append(feed_title);
+}
+
+void FeedDownloadResults::appendFilterTiming(const QString& filter_name, qint64 microseconds) {
+  QPair<int, qint64>& timing = m_filterTimings[filter_name];
+
+  timing.first++;
+  timing.second += microseconds;
+}
+
 void FeedDownloadResults::sort() {
   std::sort(m_updatedFeeds.begin(), m_updatedFeeds.end(), [](const QPair<QString, int>& lhs, const QPair<QString, int>& rhs) {
     return lhs.second > rhs.second;
@@ -236,8 +461,27 @@ void FeedDownloadResults::sort() {
 
 void FeedDownloadResults::clear() {
   m_updatedFeeds.clear();
+  m_notModifiedFeeds.clear();
+  m_unchangedFeeds.clear();
+  m_filterTimings.clear();
 }
 
 QList<QPair<QString, int>> FeedDownloadResults::updatedFeeds() const {
   return m_updatedFeeds;
 }
+
+QStringList FeedDownloadResults::notModifiedFeeds() const {
+  return m_notModifiedFeeds;
+}
+
+QStringList FeedDownloadResults::unchangedFeeds() const {
+  return m_unchangedFeeds;
+}
+
+QHash<QString, QPair<int, qint64>> FeedDownloadResults::filterTimings() const {
+  return m_filterTimings;
+}
+
+int FeedDownloadResults::skippedFeedsCount() const {
+  return m_notModifiedFeeds.size() + m_unchangedFeeds.size();
+}
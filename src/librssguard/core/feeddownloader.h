@@ -5,21 +5,35 @@
 
 #include <QObject>
 
+#include <QHash>
+#include <QJSValue>
 #include <QPair>
+#include <QSqlDatabase>
+#include <QWaitCondition>
 
 #include "core/message.h"
+#include "services/abstract/feed.h"
 
-class Feed;
 class MessageFilter;
+class MessageObject;
+class QJSEngine;
 class QMutex;
+class QThreadPool;
 
 // Represents results of batch feed updates.
 class FeedDownloadResults {
   public:
     QList<QPair<QString, int>> updatedFeeds() const;
+    QStringList notModifiedFeeds() const;
+    QStringList unchangedFeeds() const;
+    int skippedFeedsCount() const;
+    QHash<QString, QPair<int, qint64>> filterTimings() const;
     QString overview(int how_many_feeds) const;
 
     void appendUpdatedFeed(const QPair<QString, int>& feed);
+    void appendNotModifiedFeed(const QString& feed_title);
+    void appendUnchangedFeed(const QString& feed_title);
+    void appendFilterTiming(const QString& filter_name, qint64 microseconds);
     void sort();
     void clear();
 
@@ -27,9 +41,31 @@ class FeedDownloadResults {
 
     // QString represents title if the feed, int represents count of newly downloaded messages.
     QList<QPair<QString, int>> m_updatedFeeds;
+
+    // Titles of feeds which were not changed since their last update.
+    QStringList m_notModifiedFeeds;
+
+    // Titles of feeds whose downloaded data were identical to those from their last update.
+    QStringList m_unchangedFeeds;
+
+    // Names of message filters with count of filtered messages and total
+    // time (in microseconds) spent in the filter.
+    QHash<QString, QPair<int, qint64>> m_filterTimings;
+};
+
+// Represents feed which was downloaded (and parsed) by
+// worker thread and waits for its messages to be stored in DB.
+struct DownloadedFeed {
+  Feed* m_feed;
+  QString m_lane;
+  QList<Message> m_messages;
+  bool m_errorDuringObtaining;
+  Feed::DataChange m_dataChange;
 };
 
 // This class offers means to "update" feeds and "special" categories.
+// Feeds are downloaded and parsed concurrently on worker threads while
+// storing of messages in DB is serialized in thread of this object.
 // NOTE: This class is used within separate thread.
 class FeedDownloader : public QObject {
   Q_OBJECT
@@ -50,15 +86,50 @@ class FeedDownloader : public QObject {
     void updateProgress(const Feed* feed, int current, int total);
 
   private:
-    void updateOneFeed(Feed* feed);
+    friend class FeedDownloadTask;
+
+    // Called from worker threads when feed is downloaded.
+    void feedDownloaded(const DownloadedFeed& downloaded_feed);
+
+    // Starts downloads of pending feeds while respecting
+    // limits of parallel downloads.
+    // NOTE: Pipeline mutex must be locked when calling this.
+    void startPendingDownloads();
+    QString downloadLane(const Feed* feed) const;
+    int downloadLaneLimit(const Feed* feed) const;
+
+    void storeMessages(DownloadedFeed& downloaded_feed);
+
+    // Counts stored feed and reports progress unless the update was stopped.
+    void reportFeedProgress(Feed* feed);
+
     void updateAvailableFeeds();
     void finalizeUpdate();
 
+    // Prepares shared JavaScript engine for filtering of messages of given feed.
+    void prepareFilterEngine(Feed* feed);
+    void clearFilterEngine();
+
     QList<Feed*> m_feeds;
     QMutex* m_mutex;
+    QMutex* m_pipelineMutex;
+    QWaitCondition m_pipelineCondition;
+    QThreadPool* m_downloadPool;
+    QList<DownloadedFeed> m_downloadedFeeds;
+    QHash<QString, int> m_activeLanes;
+    int m_downloadsRunning;
+    int m_maxParallelDownloads;
+    int m_maxParallelDownloadsPerHost;
     FeedDownloadResults m_results;
     int m_feedsUpdated;
     int m_feedsOriginalCount;
+
+    // JavaScript engine for message filters is shared by all feeds
+    // of single update run. Each filter is compiled only once per run.
+    QJSEngine* m_filterEngine;
+    MessageObject* m_filterMessageObject;
+    QSqlDatabase m_filterDatabase;
+    QHash<int, QJSValue> m_compiledFilters;
 };
 
 #endif // FEEDDOWNLOADER_H
@@ -95,6 +95,8 @@ class RSSGUARD_DLLSPEC FeedsModel : public QAbstractItemModel {
     void stopServiceAccounts();
 
     // Reloads counts of all feeds/categories/whatever in the model.
+    // NOTE: Counts are normally adjusted incrementally when messages
+    // change, full recount is needed only after bulk changes in DB.
     void reloadCountsOfWholeModel();
 
     // Checks if new parent node is different from one used by original node.
@@ -2,6 +2,9 @@
 
 #include "core/message.h"
 
+#include "core/duplicatemessageindex.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
 #include "miscellaneous/textfactory.h"
 
 #include <QSqlDatabase>
@@ -59,7 +62,7 @@ Message::Message() {
   m_title = m_url = m_author = m_contents = m_feedId = m_customId = m_customHash = "";
   m_enclosures = QList<Enclosure>();
   m_accountId = m_id = 0;
-  m_isRead = m_isImportant = false;
+  m_isRead = m_isImportant = m_isDeleted = m_isPdeleted = false;
 }
 
 Message Message::fromSqlRecord(const QSqlRecord& record, bool* result) {
@@ -76,6 +79,8 @@ Message Message::fromSqlRecord(const QSqlRecord& record, bool* result) {
   message.m_id = record.value(MSG_DB_ID_INDEX).toInt();
   message.m_isRead = record.value(MSG_DB_READ_INDEX).toBool();
   message.m_isImportant = record.value(MSG_DB_IMPORTANT_INDEX).toBool();
+  message.m_isDeleted = record.value(MSG_DB_DELETED_INDEX).toBool();
+  message.m_isPdeleted = record.value(MSG_DB_PDELETED_INDEX).toBool();
   message.m_feedId = record.value(MSG_DB_FEED_CUSTOM_ID_INDEX).toString();
   message.m_title = record.value(MSG_DB_TITLE_INDEX).toString();
   message.m_url = record.value(MSG_DB_URL_INDEX).toString();
@@ -137,6 +142,56 @@ uint qHash(const Message& key) {
   return (uint(key.m_accountId) * 10000) + uint(key.m_id);
 }
 
+void MessageCountsDelta::addMessage(const Message& message) {
+  changeCounts(message, 1);
+}
+
+void MessageCountsDelta::removeMessage(const Message& message) {
+  changeCounts(message, -1);
+}
+
+void MessageCountsDelta::merge(const MessageCountsDelta& other) {
+  for (auto i = other.m_feeds.constBegin(); i != other.m_feeds.constEnd(); i++) {
+    QPair<int, int>& feed_counts = m_feeds[i.key()];
+
+    feed_counts.first += i.value().first;
+    feed_counts.second += i.value().second;
+  }
+
+  m_important.first += other.m_important.first;
+  m_important.second += other.m_important.second;
+  m_bin.first += other.m_bin.first;
+  m_bin.second += other.m_bin.second;
+}
+
+bool MessageCountsDelta::isEmpty() const {
+  return m_feeds.isEmpty() && m_important == QPair<int, int>() && m_bin == QPair<int, int>();
+}
+
+void MessageCountsDelta::changeCounts(const Message& message, int difference) {
+  const int unread_difference = message.m_isRead ? 0 : difference;
+
+  if (message.m_isPdeleted) {
+    // Purged messages are not counted anywhere.
+    return;
+  }
+  else if (message.m_isDeleted) {
+    m_bin.first += unread_difference;
+    m_bin.second += difference;
+  }
+  else {
+    QPair<int, int>& feed_counts = m_feeds[message.m_feedId];
+
+    feed_counts.first += unread_difference;
+    feed_counts.second += difference;
+
+    if (message.m_isImportant) {
+      m_important.first += unread_difference;
+      m_important.second += difference;
+    }
+  }
+}
+
 MessageObject::MessageObject(QSqlDatabase* db, const QString& feed_custom_id, int account_id, QObject* parent)
   : QObject(parent), m_db(db), m_feedCustomId(feed_custom_id), m_accountId(account_id), m_message(nullptr) {}
 
@@ -150,53 +205,88 @@ bool MessageObject::isDuplicateWithAttribute(int attribute_check) const {
     return true;
   }
 
-  // Check database according to duplication attribute_check.
   DuplicationAttributeCheck attrs = static_cast<DuplicationAttributeCheck>(attribute_check);
-  QSqlQuery q(*m_db);
-  QStringList where_clauses;
-  QList<QPair<QString, QVariant>> bind_values;
+  const qint64 date_created = created().toMSecsSinceEpoch();
+
+  // Most messages are not duplicates, in-memory index tells so without touching database.
+  if (!qApp->feedReader()->duplicateMessageIndex()->mayBeDuplicate(*m_db, accountId(), attrs, title(), url(),
+                                                                   author(), date_created, feedCustomId())) {
+    return false;
+  }
+
+  // Check database according to duplication attribute_check.
+  auto cached_query = m_duplicateQueries.find(attribute_check);
+
+  if (cached_query == m_duplicateQueries.end()) {
+    QStringList where_clauses;
+
+    // Now we construct the query according to parameter.
+    if ((attrs& DuplicationAttributeCheck::SameTitle) == DuplicationAttributeCheck::SameTitle) {
+      where_clauses.append(QSL("title = :title"));
+    }
+
+    if ((attrs& DuplicationAttributeCheck::SameUrl) == DuplicationAttributeCheck::SameUrl) {
+      where_clauses.append(QSL("url = :url"));
+    }
+
+    if ((attrs& DuplicationAttributeCheck::SameAuthor) == DuplicationAttributeCheck::SameAuthor) {
+      where_clauses.append(QSL("author = :author"));
+    }
+
+    if ((attrs& DuplicationAttributeCheck::SameDateCreated) == DuplicationAttributeCheck::SameDateCreated) {
+      where_clauses.append(QSL("date_created = :date_created"));
+    }
+
+    where_clauses.append(QSL("account_id = :account_id"));
+
+    if ((attrs& DuplicationAttributeCheck::AllFeedsSameAccount) != DuplicationAttributeCheck::AllFeedsSameAccount) {
+      // Limit to current feed.
+      where_clauses.append(QSL("feed = :feed"));
+    }
+
+    QSqlQuery q(*m_db);
+
+    q.setForwardOnly(true);
+
+    if (!q.prepare(QSL("SELECT 1 FROM Messages WHERE ") + where_clauses.join(QSL(" AND ")) + QSL(" LIMIT 1;"))) {
+      qWarning("Error when preparing check for duplicate messages via filtering system, error: '%s'.",
+               qPrintable(q.lastError().text()));
+      return false;
+    }
+
+    cached_query = m_duplicateQueries.insert(attribute_check, q);
+  }
+
+  QSqlQuery& q = cached_query.value();
 
-  // Now we construct the query according to parameter.
   if ((attrs& DuplicationAttributeCheck::SameTitle) == DuplicationAttributeCheck::SameTitle) {
-    where_clauses.append(QSL("title = :title"));
-    bind_values.append({":title", title()});
+    q.bindValue(QSL(":title"), title());
   }
 
   if ((attrs& DuplicationAttributeCheck::SameUrl) == DuplicationAttributeCheck::SameUrl) {
-    where_clauses.append(QSL("url = :url"));
-    bind_values.append({":url", url()});
+    q.bindValue(QSL(":url"), url());
   }
 
   if ((attrs& DuplicationAttributeCheck::SameAuthor) == DuplicationAttributeCheck::SameAuthor) {
-    where_clauses.append(QSL("author = :author"));
-    bind_values.append({":author", author()});
+    q.bindValue(QSL(":author"), author());
   }
 
   if ((attrs& DuplicationAttributeCheck::SameDateCreated) == DuplicationAttributeCheck::SameDateCreated) {
-    where_clauses.append(QSL("date_created = :date_created"));
-    bind_values.append({":date_created", created().toMSecsSinceEpoch()});
+    q.bindValue(QSL(":date_created"), date_created);
   }
 
-  where_clauses.append(QSL("account_id = :account_id"));
-  bind_values.append({":account_id", accountId()});
+  q.bindValue(QSL(":account_id"), accountId());
 
   if ((attrs& DuplicationAttributeCheck::AllFeedsSameAccount) != DuplicationAttributeCheck::AllFeedsSameAccount) {
-    // Limit to current feed.
-    where_clauses.append(QSL("feed = :feed"));
-    bind_values.append({":feed", feedCustomId()});
+    q.bindValue(QSL(":feed"), feedCustomId());
   }
 
-  QString full_query = QSL("SELECT COUNT(*) FROM Messages WHERE ") + where_clauses.join(QSL(" AND ")) + QSL(";");
+  if (q.exec()) {
+    const bool is_duplicate = q.next();
 
-  q.setForwardOnly(true);
-  q.prepare(full_query);
+    q.finish();
 
-  for (const auto& bind : bind_values) {
-    q.bindValue(bind.first, bind.second);
-  }
-
-  if (q.exec() && q.next()) {
-    if (q.record().value(0).toInt() > 0) {
+    if (is_duplicate) {
       // Whoops, we have the "same" message in database.
       qDebug("Message '%s' was identified as duplicate by filter script.", qPrintable(title()));
       return true;
@@ -270,6 +360,14 @@ QString MessageObject::feedCustomId() const {
   return m_feedCustomId;
 }
 
+void MessageObject::setFeedCustomId(const QString& feed_custom_id) {
+  m_feedCustomId = feed_custom_id;
+}
+
 int MessageObject::accountId() const {
   return m_accountId;
 }
+
+void MessageObject::setAccountId(int account_id) {
+  m_accountId = account_id;
+}
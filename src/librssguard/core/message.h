@@ -7,6 +7,8 @@
 
 #include <QDataStream>
 #include <QDateTime>
+#include <QHash>
+#include <QSqlQuery>
 #include <QSqlRecord>
 #include <QStringList>
 
@@ -48,6 +50,8 @@ class Message {
     QString m_customHash;
     bool m_isRead;
     bool m_isImportant;
+    bool m_isDeleted;
+    bool m_isPdeleted;
     QList<Enclosure> m_enclosures;
 
     // Is true if "created" date was obtained directly
@@ -72,6 +76,29 @@ QDataStream& operator>>(QDataStream& in, Message& myObj);
 uint qHash(const Message& key, uint seed);
 uint qHash(const Message& key);
 
+// Represents changes of unread/all message counts of feeds, of recycle bin
+// and of important messages caused by some operation with messages.
+// Counts of items can be then adjusted without recounting messages in DB.
+class MessageCountsDelta {
+  public:
+
+    // Adds message with given state to counts or removes it from them.
+    // Change of message state is represented by removing message with
+    // old state and adding message with new state.
+    void addMessage(const Message& message);
+    void removeMessage(const Message& message);
+    void merge(const MessageCountsDelta& other);
+    bool isEmpty() const;
+
+    // Keys are custom IDs of feeds, values are changes of unread/all counts.
+    QHash<QString, QPair<int, int>> m_feeds;
+    QPair<int, int> m_important;
+    QPair<int, int> m_bin;
+
+  private:
+    void changeCounts(const Message& message, int difference);
+};
+
 enum class FilteringAction {
   // Message is normally accepted and stored in DB.
   Accept = 1,
@@ -130,7 +157,10 @@ class MessageObject : public QObject {
 
     // Generic Message's properties bindings.
     QString feedCustomId() const;
+    void setFeedCustomId(const QString& feed_custom_id);
+
     int accountId() const;
+    void setAccountId(int account_id);
 
     QString title() const;
     void setTitle(const QString& title);
@@ -158,6 +188,9 @@ class MessageObject : public QObject {
     QString m_feedCustomId;
     int m_accountId;
     Message* m_message;
+
+    // Prepared queries for duplicate checks, keys are combinations of DuplicationAttributeCheck flags.
+    mutable QHash<int, QSqlQuery> m_duplicateQueries;
 };
 
 #endif // MESSAGE_H
@@ -41,16 +41,29 @@ FilteringAction MessageFilter::filterMessage(QJSEngine* engine) {
         return helper();
       }
    */
-  QJSValue filter_func = engine->evaluate(m_script);
+  return runFilter(compileFilter(engine));
+}
+
+QJSValue MessageFilter::compileFilter(QJSEngine* engine) const {
+  // NOTE: Script is evaluated in its own function scope, so
+  // that functions of more filters can live in one engine.
+  return engine->evaluate(QSL("(function() {\n") + m_script + QSL("\nreturn filterMessage;\n})()"), QString(), 0);
+}
 
-  if (filter_func.isError()) {
-    QJSValue::ErrorType error = filter_func.errorType();
-    QString message = filter_func.toString();
+FilteringAction MessageFilter::runFilter(const QJSValue& compiled_filter) {
+  if (compiled_filter.isError()) {
+    QJSValue::ErrorType error = compiled_filter.errorType();
+    QString message = compiled_filter.toString();
 
     throw FilteringException(error, message);
   }
 
-  auto filter_output = engine->evaluate(QSL("filterMessage()"));
+  if (!compiled_filter.isCallable()) {
+    throw FilteringException(QJSValue::TypeError, QSL("TypeError: filterMessage is not a function"));
+  }
+
+  QJSValue filter_func = compiled_filter;
+  QJSValue filter_output = filter_func.call();
 
   if (filter_output.isError()) {
     QJSValue::ErrorType error = filter_output.errorType();
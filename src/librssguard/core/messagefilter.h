@@ -7,6 +7,8 @@
 
 #include "core/message.h"
 
+#include <QJSValue>
+
 class QJSEngine;
 
 // Class which represents one message filter.
@@ -18,6 +20,13 @@ class MessageFilter : public QObject {
 
     FilteringAction filterMessage(QJSEngine* engine);
 
+    // Evaluates script of the filter and returns its "filterMessage()" function,
+    // which can be then called for many messages with runFilter().
+    // Error value is returned if the script cannot be evaluated.
+    QJSValue compileFilter(QJSEngine* engine) const;
+
+    static FilteringAction runFilter(const QJSValue& compiled_filter);
+
     int id() const;
     void setId(int id);
 
@@ -0,0 +1,93 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "core/messagesanitizer.h"
+
+#include "definitions/definitions.h"
+
+#include <QUrl>
+
+void MessageSanitizer::sanitizeMessage(Message& message) {
+  // Also, make sure that HTML encoding, encoding of special characters, etc., is fixed.
+  message.m_contents = fromPercentEncoding(message.m_contents);
+  message.m_author = message.m_author.toUtf8();
+
+  // Sanitize title. Remove newlines etc.
+  message.m_title = sanitizeTitle(fromPercentEncoding(message.m_title));
+}
+
+QString MessageSanitizer::fromPercentEncoding(const QString& text) {
+  if (!text.contains(QL1C('%'))) {
+    return text;
+  }
+  else {
+    return QUrl::fromPercentEncoding(text.toUtf8());
+  }
+}
+
+QString MessageSanitizer::sanitizeTitle(const QString& title) {
+  QString output;
+  const int length = title.size();
+  int i = 0;
+
+  output.reserve(length);
+
+  while (i < length) {
+    if (!title.at(i).isSpace()) {
+      output.append(title.at(i++));
+      continue;
+    }
+
+    const int run_start = i;
+
+    while (i < length && title.at(i).isSpace()) {
+      i++;
+    }
+
+    if (run_start == 0) {
+      // Leading white space is removed completely.
+      continue;
+    }
+    else if (i - run_start > 1) {
+      // Continuous white space is replaced with single space.
+      output.append(QL1C(' '));
+    }
+    else if (title.at(run_start) != QL1C('\n') && title.at(run_start) != QL1C('\r')) {
+      output.append(title.at(run_start));
+    }
+  }
+
+  return output;
+}
+
+QString MessageSanitizer::sanitizeUrl(QString url) {
+  return url.remove(QL1C('\t')).remove(QL1C('\n'));
+}
+
+QString MessageSanitizer::stripTags(const QString& text) {
+  int tag_start = text.indexOf(QL1C('<'));
+
+  if (tag_start < 0) {
+    return text;
+  }
+
+  QString output;
+  int copy_from = 0;
+
+  output.reserve(text.size());
+
+  while (tag_start >= 0) {
+    const int tag_end = text.indexOf(QL1C('>'), tag_start + 1);
+
+    if (tag_end < 0) {
+      // Unclosed tag is kept in text.
+      break;
+    }
+
+    output.append(text.midRef(copy_from, tag_start - copy_from));
+    copy_from = tag_end + 1;
+    tag_start = text.indexOf(QL1C('<'), copy_from);
+  }
+
+  output.append(text.midRef(copy_from));
+  return output;
+}
@@ -0,0 +1,36 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef MESSAGESANITIZER_H
+#define MESSAGESANITIZER_H
+
+#include "core/message.h"
+
+#include <QString>
+
+// Cleans up texts of downloaded messages. All methods are reentrant and
+// use hand-written scanners, so they can be called from worker threads
+// for each message without compiling any regular expressions.
+class MessageSanitizer {
+  public:
+
+    // Fixes encoding of contents, title and author of downloaded message.
+    static void sanitizeMessage(Message& message);
+
+    // Decodes percent-encoded text, text without "%" characters is returned as it is.
+    static QString fromPercentEncoding(const QString& text);
+
+    // Collapses all continuous white space into single space, removes
+    // standalone newlines and leading white space.
+    static QString sanitizeTitle(const QString& title);
+
+    // Removes all tab and newline characters from URL.
+    static QString sanitizeUrl(QString url);
+
+    // Removes all "<...>" HTML tags from text.
+    static QString stripTags(const QString& text);
+
+  private:
+    explicit MessageSanitizer() = delete;
+};
+
+#endif // MESSAGESANITIZER_H
@@ -15,9 +15,11 @@
 
 #include <QSqlError>
 #include <QSqlField>
+#include <QSqlQuery>
 
 MessagesModel::MessagesModel(QObject* parent)
-  : QSqlQueryModel(parent), m_cache(new MessagesModelCache(this)), m_messageHighlighter(MessageHighlighter::NoHighlighting),
+  : QAbstractTableModel(parent), m_cache(new MessagesModelCache(this)), m_rowCount(0),
+  m_messageHighlighter(MessageHighlighter::NoHighlighting),
   m_customDateFormat(QString()), m_selectedItem(nullptr), m_itemHeight(-1) {
   setupFonts();
   setupIcons();
@@ -37,29 +39,230 @@ void MessagesModel::setupIcons() {
   m_enclosuresIcon = qApp->icons()->fromTheme(QSL("mail-attachment"));
 }
 
+std::function<void(int, int)> MessagesModel::updateProgressReporter() {
+  return [this](int done, int total) {
+    emit messagesUpdateProgress(done, total);
+  };
+}
+
 MessagesModelCache* MessagesModel::cache() const
 {
   return m_cache;
 }
 
 void MessagesModel::repopulate() {
+  beginResetModel();
+
   m_cache->clear();
-  setQuery(selectStatement(), m_db);
+  m_pages.clear();
+  m_pagesUsage.clear();
+  m_pageIds.clear();
+  m_rowsById.clear();
+
+  QSqlQuery q(m_db);
 
-  if (lastError().isValid()) {
-    qCritical() << "Error when setting new msg view query:" << lastError().text();
-    qCritical() << "Used SQL select statement:" << selectStatement();
+  q.setForwardOnly(true);
+
+  if (q.exec(countStatement()) && q.next()) {
+    m_rowCount = q.value(0).toInt();
+  }
+  else {
+    m_rowCount = 0;
+    qCritical() << "Error when counting messages for msg view:" << q.lastError().text();
+    qCritical() << "Used SQL count statement:" << countStatement();
   }
 
-  while (canFetchMore()) {
-    fetchMore();
+  endResetModel();
+}
+
+QSqlRecord MessagesModel::record(int row) const {
+  if (row < 0 || row >= m_rowCount) {
+    return QSqlRecord();
+  }
+
+  const int page = row / MSG_MODEL_PAGE_SIZE;
+  const int row_in_page = row % MSG_MODEL_PAGE_SIZE;
+
+  if (m_pages.contains(page)) {
+    m_pagesUsage.removeOne(page);
+    m_pagesUsage.append(page);
   }
+  else {
+    fetchPage(page);
+  }
+
+  const QVector<QSqlRecord> records = m_pages.value(page);
+
+  // Load neighbouring window in advance when user
+  // is getting close to the edge of current one.
+  if (row_in_page >= MSG_MODEL_PAGE_SIZE - MSG_MODEL_PREFETCH_MARGIN &&
+      (page + 1) * MSG_MODEL_PAGE_SIZE < m_rowCount &&
+      !m_pages.contains(page + 1)) {
+    fetchPage(page + 1);
+  }
+  else if (row_in_page < MSG_MODEL_PREFETCH_MARGIN && page > 0 && !m_pages.contains(page - 1)) {
+    fetchPage(page - 1);
+  }
+
+  return row_in_page < records.size() ? records.at(row_in_page) : QSqlRecord();
+}
+
+void MessagesModel::fetchPage(int page) const {
+  const int first_row = page * MSG_MODEL_PAGE_SIZE;
+  const QList<int> ids = pageIds(page);
+  const QString statement = selectStatement(ids);
+
+  // NOTE: Rows of messages which were purged from DB
+  // meanwhile are left empty.
+  QVector<QSqlRecord> records(ids.size());
+
+  if (!ids.isEmpty()) {
+    QSqlQuery q(m_db);
+
+    q.setForwardOnly(true);
+
+    if (q.exec(statement)) {
+      while (q.next()) {
+        const int row_in_page = m_rowsById.value(q.value(MSG_DB_ID_INDEX).toInt(), -1) - first_row;
+
+        if (row_in_page >= 0 && row_in_page < records.size()) {
+          records[row_in_page] = q.record();
+        }
+      }
+    }
+    else {
+      qCritical() << "Error when fetching messages for msg view:" << q.lastError().text();
+      qCritical() << "Used SQL select statement:" << statement;
+    }
+  }
+
+  m_pages.insert(page, records);
+  m_pagesUsage.removeOne(page);
+  m_pagesUsage.append(page);
+
+  while (m_pagesUsage.size() > MSG_MODEL_MAX_CACHED_PAGES) {
+    m_pages.remove(m_pagesUsage.takeFirst());
+  }
+}
+
+bool MessagesModel::messageState(int row, int column) const {
+  return m_cache->containsData(index(row, column)) ?
+         m_cache->value(row, column) :
+         record(row).value(column).toInt() == 1;
+}
+
+QList<int> MessagesModel::pageIds(int page) const {
+  if (!m_pageIds.contains(page)) {
+    const int first_row = page * MSG_MODEL_PAGE_SIZE;
+    const QString statement = idStatement(qMin(MSG_MODEL_PAGE_SIZE, m_rowCount - first_row), first_row);
+    QList<int> ids;
+    QSqlQuery q(m_db);
+
+    q.setForwardOnly(true);
+
+    if (q.exec(statement)) {
+      while (q.next()) {
+        ids.append(q.value(0).toInt());
+      }
+    }
+    else {
+      qCritical() << "Error when loading IDs of messages for msg view:" << q.lastError().text();
+      qCritical() << "Used SQL ID statement:" << statement;
+    }
+
+    pinPageIds(page, ids);
+  }
+
+  return m_pageIds.value(page);
+}
+
+void MessagesModel::pinPageIds(int page, const QList<int>& ids) const {
+  const int first_row = page * MSG_MODEL_PAGE_SIZE;
+  QList<int> page_ids;
+
+  page_ids.reserve(ids.size());
+
+  for (int id : ids) {
+    if (m_rowsById.contains(id)) {
+      // Messages were changed since some other window was pinned and
+      // this message moved here from it. Message stays in its first row.
+      page_ids.append(0);
+    }
+    else {
+      m_rowsById.insert(id, first_row + page_ids.size());
+      page_ids.append(id);
+    }
+  }
+
+  m_pageIds.insert(page, page_ids);
+}
+
+int MessagesModel::rowForMessageId(int id) const {
+  const int page_count = (m_rowCount + MSG_MODEL_PAGE_SIZE - 1) / MSG_MODEL_PAGE_SIZE;
+
+  if (m_rowsById.contains(id) || m_pageIds.size() >= page_count) {
+    return m_rowsById.value(id, -1);
+  }
+
+  // IDs of all remaining windows are loaded in single pass
+  // which stops right after window with the message.
+  const QString statement = idStatement();
+  QSqlQuery q(m_db);
+
+  q.setForwardOnly(true);
+
+  if (!q.exec(statement)) {
+    qCritical() << "Error when looking up message for msg view:" << q.lastError().text();
+    qCritical() << "Used SQL ID statement:" << statement;
+    return -1;
+  }
+
+  QList<int> ids;
+  int row = 0;
+
+  while (row < m_rowCount && q.next()) {
+    const int page = row++ / MSG_MODEL_PAGE_SIZE;
+
+    if (m_pageIds.contains(page)) {
+      continue;
+    }
+
+    ids.append(q.value(0).toInt());
+
+    if (row % MSG_MODEL_PAGE_SIZE == 0 || row == m_rowCount) {
+      pinPageIds(page, ids);
+      ids.clear();
+
+      if (m_rowsById.contains(id)) {
+        break;
+      }
+    }
+  }
+
+  if (!ids.isEmpty()) {
+    // Some messages were removed from DB meanwhile, last window is shorter.
+    pinPageIds((row - 1) / MSG_MODEL_PAGE_SIZE, ids);
+  }
+
+  return m_rowsById.value(id, -1);
+}
+
+int MessagesModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : m_rowCount;
+}
+
+int MessagesModel::columnCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : MSG_DB_HAS_ENCLOSURES + 1;
 }
 
 bool MessagesModel::setData(const QModelIndex& index, const QVariant& value, int role) {
   Q_UNUSED(role)
-  m_cache->setData(index, value, record(index.row()));
-  return true;
+
+  if (index.column() == MSG_DB_READ_INDEX && value.toInt() == RootItem::Read) {
+    keepMessageVisible(messageId(index.row()));
+  }
+
+  return m_cache->setData(index, value);
 }
 
 void MessagesModel::setupFonts() {
@@ -107,21 +310,19 @@ void MessagesModel::loadMessages(RootItem* item) {
 }
 
 bool MessagesModel::setMessageImportantById(int id, RootItem::Importance important) {
-  for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+  const int row = rowForMessageId(id);
 
-    if (found_id == id) {
-      bool set = setData(index(i, MSG_DB_IMPORTANT_INDEX), important);
+  if (row < 0) {
+    return false;
+  }
 
-      if (set) {
-        emit dataChanged(index(i, 0), index(i, MSG_DB_CUSTOM_HASH_INDEX));
-      }
+  bool set = setData(index(row, MSG_DB_IMPORTANT_INDEX), important);
 
-      return set;
-    }
+  if (set) {
+    emit dataChanged(index(row, 0), index(row, MSG_DB_CUSTOM_HASH_INDEX));
   }
 
-  return false;
+  return set;
 }
 
 void MessagesModel::highlightMessages(MessagesModel::MessageHighlighter highlight) {
@@ -131,7 +332,14 @@ void MessagesModel::highlightMessages(MessagesModel::MessageHighlighter highligh
 }
 
 int MessagesModel::messageId(int row_index) const {
-  return data(row_index, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+  if (row_index < 0 || row_index >= m_rowCount) {
+    return 0;
+  }
+
+  const QList<int> ids = pageIds(row_index / MSG_MODEL_PAGE_SIZE);
+  const int row_in_page = row_index % MSG_MODEL_PAGE_SIZE;
+
+  return row_in_page < ids.size() ? ids.at(row_in_page) : 0;
 }
 
 RootItem::Importance MessagesModel::messageImportance(int row_index) const {
@@ -157,7 +365,17 @@ void MessagesModel::reloadWholeLayout() {
 }
 
 Message MessagesModel::messageAt(int row_index) const {
-  return Message::fromSqlRecord(m_cache->containsData(row_index) ? m_cache->record(row_index) : record(row_index));
+  return Message::fromSqlRecord(m_cache->record(row_index, record(row_index)));
+}
+
+Message MessagesModel::fullMessageAt(int row_index) const {
+  Message message = messageAt(row_index);
+
+  if (message.m_id > 0) {
+    message.m_contents = DatabaseQueries::getMessageContents(m_db, message.m_id);
+  }
+
+  return message;
 }
 
 void MessagesModel::setupHeaderData() {
@@ -226,7 +444,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       int index_column = idx.column();
 
       if (index_column == MSG_DB_DCREATED_INDEX) {
-        QDateTime dt = TextFactory::parseDateTime(QSqlQueryModel::data(idx, role).value<qint64>()).toLocalTime();
+        QDateTime dt = TextFactory::parseDateTime(record(idx.row()).value(idx.column()).value<qint64>()).toLocalTime();
 
         if (m_customDateFormat.isEmpty()) {
           return QLocale().toString(dt, QLocale::FormatType::ShortFormat);
@@ -242,12 +460,12 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
         return contents;
       }
       else if (index_column == MSG_DB_AUTHOR_INDEX) {
-        const QString author_name = QSqlQueryModel::data(idx, role).toString();
+        const QString author_name = record(idx.row()).value(idx.column()).toString();
 
         return author_name.isEmpty() ? QSL("-") : author_name;
       }
       else if (index_column != MSG_DB_IMPORTANT_INDEX && index_column != MSG_DB_READ_INDEX && index_column != MSG_DB_HAS_ENCLOSURES) {
-        return QSqlQueryModel::data(idx, role);
+        return record(idx.row()).value(idx.column());
       }
       else {
         return QVariant();
@@ -255,28 +473,13 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
     }
 
     case Qt::EditRole:
-      return m_cache->containsData(idx.row()) ? m_cache->data(idx) : QSqlQueryModel::data(idx, role);
+      return m_cache->containsData(idx) ? m_cache->data(idx) : record(idx.row()).value(idx.column());
 
     case Qt::FontRole: {
-      QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-      QVariant data_read = data(idx_read, Qt::EditRole);
       const bool is_bin = qobject_cast<RecycleBin*>(loadedItem()) != nullptr;
-      bool is_deleted;
-
-      if (is_bin) {
-        QModelIndex idx_del = index(idx.row(), MSG_DB_PDELETED_INDEX);
+      const bool striked = messageState(idx.row(), is_bin ? MSG_DB_PDELETED_INDEX : MSG_DB_DELETED_INDEX);
 
-        is_deleted = data(idx_del, Qt::EditRole).toBool();
-      }
-      else {
-        QModelIndex idx_del = index(idx.row(), MSG_DB_DELETED_INDEX);
-
-        is_deleted = data(idx_del, Qt::EditRole).toBool();
-      }
-
-      const bool striked = is_deleted;
-
-      if (data_read.toBool()) {
+      if (messageState(idx.row(), MSG_DB_READ_INDEX)) {
         return striked ? m_normalStrikedFont : m_normalFont;
       }
       else {
@@ -287,17 +490,11 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
     case Qt::ForegroundRole:
       switch (m_messageHighlighter) {
         case MessageHighlighter::HighlightImportant: {
-          QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
-          QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important) : QSqlQueryModel::data(idx_important);
-
-          return dta.toInt() == 1 ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
+          return messageState(idx.row(), MSG_DB_IMPORTANT_INDEX) ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
         }
 
         case MessageHighlighter::HighlightUnread: {
-          QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-          QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
-
-          return dta.toInt() == 0 ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
+          return !messageState(idx.row(), MSG_DB_READ_INDEX) ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
         }
 
         case MessageHighlighter::NoHighlighting:
@@ -309,20 +506,14 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       const int index_column = idx.column();
 
       if (index_column == MSG_DB_READ_INDEX) {
-        QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-        QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
-
-        return dta.toInt() == 1 ? m_readIcon : m_unreadIcon;
+        return messageState(idx.row(), MSG_DB_READ_INDEX) ? m_readIcon : m_unreadIcon;
       }
       else if (index_column == MSG_DB_IMPORTANT_INDEX) {
-        QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
-        QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important) : QSqlQueryModel::data(idx_important);
-
-        return dta.toInt() == 1 ? m_favoriteIcon : QVariant();
+        return messageState(idx.row(), MSG_DB_IMPORTANT_INDEX) ? m_favoriteIcon : QVariant();
       }
       else if (index_column == MSG_DB_HAS_ENCLOSURES) {
         QModelIndex idx_important = index(idx.row(), MSG_DB_HAS_ENCLOSURES);
-        QVariant dta = QSqlQueryModel::data(idx_important);
+        QVariant dta = record(idx_important.row()).value(idx_important.column());
 
         return dta.toBool() ? m_enclosuresIcon : QVariant();
       }
@@ -368,21 +559,19 @@ bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
 }
 
 bool MessagesModel::setMessageReadById(int id, RootItem::ReadStatus read) {
-  for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+  const int row = rowForMessageId(id);
 
-    if (found_id == id) {
-      bool set = setData(index(i, MSG_DB_READ_INDEX), read);
+  if (row < 0) {
+    return false;
+  }
 
-      if (set) {
-        emit dataChanged(index(i, 0), index(i, MSG_DB_CUSTOM_HASH_INDEX));
-      }
+  bool set = setData(index(row, MSG_DB_READ_INDEX), read);
 
-      return set;
-    }
+  if (set) {
+    emit dataChanged(index(row, 0), index(row, MSG_DB_CUSTOM_HASH_INDEX));
   }
 
-  return false;
+  return set;
 }
 
 bool MessagesModel::switchMessageImportance(int row_index) {
@@ -446,7 +635,7 @@ bool MessagesModel::switchBatchMessageImportance(const QModelIndexList& messages
     return false;
   }
 
-  if (DatabaseQueries::switchMessagesImportance(m_db, message_ids)) {
+  if (DatabaseQueries::switchMessagesImportance(m_db, message_ids, updateProgressReporter())) {
     return m_selectedItem->getParentServiceRoot()->onAfterSwitchMessageImportance(m_selectedItem, message_states);
   }
   else {
@@ -482,10 +671,10 @@ bool MessagesModel::setBatchMessagesDeleted(const QModelIndexList& messages) {
   bool deleted;
 
   if (m_selectedItem->kind() != RootItemKind::Bin) {
-    deleted = DatabaseQueries::deleteOrRestoreMessagesToFromBin(m_db, message_ids, true);
+    deleted = DatabaseQueries::deleteOrRestoreMessagesToFromBin(m_db, message_ids, true, updateProgressReporter());
   }
   else {
-    deleted = DatabaseQueries::permanentlyDeleteMessages(m_db, message_ids);
+    deleted = DatabaseQueries::permanentlyDeleteMessages(m_db, message_ids, updateProgressReporter());
   }
 
   if (deleted) {
@@ -515,7 +704,7 @@ bool MessagesModel::setBatchMessagesRead(const QModelIndexList& messages, RootIt
     return false;
   }
 
-  if (DatabaseQueries::markMessagesReadUnread(m_db, message_ids, read)) {
+  if (DatabaseQueries::markMessagesReadUnread(m_db, message_ids, read, updateProgressReporter())) {
     return m_selectedItem->getParentServiceRoot()->onAfterSetMessagesRead(m_selectedItem, msgs, read);
   }
   else {
@@ -543,7 +732,7 @@ bool MessagesModel::setBatchMessagesRestored(const QModelIndexList& messages) {
     return false;
   }
 
-  if (DatabaseQueries::deleteOrRestoreMessagesToFromBin(m_db, message_ids, false)) {
+  if (DatabaseQueries::deleteOrRestoreMessagesToFromBin(m_db, message_ids, false, updateProgressReporter())) {
     return m_selectedItem->getParentServiceRoot()->onAfterMessagesRestoredFromBin(m_selectedItem, msgs);
   }
   else {
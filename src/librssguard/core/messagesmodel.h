@@ -4,18 +4,23 @@
 #define MESSAGESMODEL_H
 
 #include "core/messagesmodelsqllayer.h"
-#include <QSqlQueryModel>
+#include <QAbstractTableModel>
 
 #include "core/message.h"
 #include "definitions/definitions.h"
 #include "services/abstract/rootitem.h"
 
 #include <QFont>
+#include <QHash>
 #include <QIcon>
+#include <QSqlRecord>
+#include <QVector>
+
+#include <functional>
 
 class MessagesModelCache;
 
-class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
+class MessagesModel : public QAbstractTableModel, public MessagesModelSqlLayer {
   Q_OBJECT
 
   public:
@@ -32,11 +37,20 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     explicit MessagesModel(QObject* parent = nullptr);
     virtual ~MessagesModel();
 
-    // Fetches ALL available data to the model.
-    // NOTE: This activates the SQL query and populates the model with new data.
+    // Resets the model and counts messages matching current filter.
+    // NOTE: Rows itself are fetched lazily in windows, see record(). IDs of each window
+    // are pinned when the window is loaded for the first time, so messages which stop
+    // matching the filter (for example deleted ones) do not disappear or shift other
+    // rows of loaded windows until next repopulation.
     void repopulate();
 
+    // Returns raw record of given row, its window is loaded if needed.
+    // NOTE: Contents of message are truncated to snippet here.
+    QSqlRecord record(int row) const;
+
     // Model implementation.
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole);
     QVariant data(const QModelIndex& idx, int role = Qt::DisplayRole) const;
     QVariant data(int row, int column, int role = Qt::DisplayRole) const;
@@ -44,8 +58,16 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     Qt::ItemFlags flags(const QModelIndex& index) const;
 
     // Returns message at given index.
+    // NOTE: Only snippet of message contents is returned, use
+    // fullMessageAt() if whole contents is needed.
     Message messageAt(int row_index) const;
+    Message fullMessageAt(int row_index) const;
     int messageId(int row_index) const;
+
+    // Returns row of message with given ID or -1 if there is no such message.
+    // NOTE: If message is not in windows with pinned IDs, then IDs of
+    // remaining windows are loaded until the message is found.
+    int rowForMessageId(int id) const;
     RootItem::Importance messageImportance(int row_index) const;
 
     RootItem* loadedItem() const;
@@ -78,11 +100,38 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     bool setMessageImportantById(int id, RootItem::Importance important);
     bool setMessageReadById(int id, RootItem::ReadStatus read);
 
+  signals:
+
+    // Emitted while large batch of messages is updated in DB.
+    void messagesUpdateProgress(int done, int total);
+
   private:
     void setupHeaderData();
     void setupIcons();
 
+    // Reports progress of batch updates via messagesUpdateProgress().
+    std::function<void(int, int)> updateProgressReporter();
+
+    // Loads one window of rows from DB, least recently
+    // used windows are dropped if there are too many of them.
+    void fetchPage(int page) const;
+
+    // Returns IDs of messages of given window, they are loaded from DB and pinned if needed.
+    QList<int> pageIds(int page) const;
+    void pinPageIds(int page, const QList<int>& ids) const;
+
+    // Returns value of boolean state column (read, important, deleted...) of given row.
+    bool messageState(int row, int column) const;
+
     MessagesModelCache* m_cache;
+    mutable QHash<int, QVector<QSqlRecord>> m_pages;
+    mutable QList<int> m_pagesUsage;
+
+    // Pinned IDs of messages of loaded windows and reverse index of them.
+    // NOTE: IDs are kept until next repopulation, even if window itself is dropped.
+    mutable QHash<int, QList<int>> m_pageIds;
+    mutable QHash<int, int> m_rowsById;
+    int m_rowCount;
     MessageHighlighter m_messageHighlighter;
     QString m_customDateFormat;
     RootItem* m_selectedItem;
@@ -2,18 +2,73 @@
 
 #include "core/messagesmodelcache.h"
 
-#include "miscellaneous/textfactory.h"
+#include "definitions/definitions.h"
 
 MessagesModelCache::MessagesModelCache(QObject* parent) : QObject(parent) {}
 
-void MessagesModelCache::setData(const QModelIndex& index, const QVariant& value, const QSqlRecord& record) {
-  if (!m_msgCache.contains(index.row())) {
-    m_msgCache[index.row()] = record;
+QSqlRecord MessagesModelCache::record(int row_idx, QSqlRecord record) const {
+  if (containsData(row_idx)) {
+    for (int column : { MSG_DB_READ_INDEX, MSG_DB_IMPORTANT_INDEX, MSG_DB_DELETED_INDEX, MSG_DB_PDELETED_INDEX }) {
+      if (m_cached[cachedColumn(column)].testBit(row_idx)) {
+        record.setValue(column, int(value(row_idx, column)));
+      }
+    }
   }
 
-  m_msgCache[index.row()].setValue(index.column(), value);
+  return record;
 }
 
-QVariant MessagesModelCache::data(const QModelIndex& idx) {
-  return m_msgCache[idx.row()].value(idx.column());
+void MessagesModelCache::clear() {
+  m_dirtyRows.clear();
+
+  for (int i = 0; i < CachedColumnsCount; i++) {
+    m_cached[i].clear();
+    m_values[i].clear();
+  }
+}
+
+bool MessagesModelCache::setData(const QModelIndex& index, const QVariant& value) {
+  const int row = index.row();
+  const int column = cachedColumn(index.column());
+
+  if (row < 0 || column == NotCached) {
+    qWarning("Column '%d' of messages cannot be cached.", index.column());
+    return false;
+  }
+
+  if (row >= m_dirtyRows.size()) {
+    // Arrays grow in chunks, so that marking of consecutive rows does not reallocate them each time.
+    const int new_size = (row / MSG_MODEL_PAGE_SIZE + 1) * MSG_MODEL_PAGE_SIZE;
+
+    m_dirtyRows.resize(new_size);
+
+    for (int i = 0; i < CachedColumnsCount; i++) {
+      m_cached[i].resize(new_size);
+      m_values[i].resize(new_size);
+    }
+  }
+
+  m_dirtyRows.setBit(row);
+  m_cached[column].setBit(row);
+  m_values[column].setBit(row, value.toInt() != 0);
+  return true;
+}
+
+int MessagesModelCache::cachedColumn(int column) {
+  switch (column) {
+    case MSG_DB_READ_INDEX:
+      return Read;
+
+    case MSG_DB_IMPORTANT_INDEX:
+      return Important;
+
+    case MSG_DB_DELETED_INDEX:
+      return Deleted;
+
+    case MSG_DB_PDELETED_INDEX:
+      return PermanentlyDeleted;
+
+    default:
+      return NotCached;
+  }
 }
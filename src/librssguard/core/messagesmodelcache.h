@@ -7,9 +7,15 @@
 
 #include "core/message.h"
 
+#include <QBitArray>
 #include <QModelIndex>
 #include <QVariant>
 
+// Holds states of messages which were changed in the model but which
+// were not reloaded from DB yet.
+//
+// Only boolean state columns (read, important, deleted, permanently deleted)
+// can be changed, so each column is stored as array of bits indexed by rows.
 class MessagesModelCache : public QObject {
   Q_OBJECT
 
@@ -17,27 +23,52 @@ class MessagesModelCache : public QObject {
     explicit MessagesModelCache(QObject* parent = nullptr);
     virtual ~MessagesModelCache() = default;
 
+    // Returns true if at least one column of given row is cached.
     bool containsData(int row_idx) const;
-    QSqlRecord record(int row_idx) const;
-    QVariant data(const QModelIndex& idx);
+    bool containsData(const QModelIndex& idx) const;
+
+    QVariant data(const QModelIndex& idx) const;
+    bool value(int row_idx, int column) const;
+
+    // Overwrites values of given record with cached ones.
+    QSqlRecord record(int row_idx, QSqlRecord record) const;
 
     void clear();
-    void setData(const QModelIndex& index, const QVariant& value, const QSqlRecord& record);
+    bool setData(const QModelIndex& index, const QVariant& value);
 
   private:
-    QHash<int, QSqlRecord> m_msgCache;
+    enum CachedColumn {
+      Read = 0,
+      Important = 1,
+      Deleted = 2,
+      PermanentlyDeleted = 3,
+      CachedColumnsCount = 4,
+      NotCached = -1
+    };
+
+    static int cachedColumn(int column);
+
+    QBitArray m_dirtyRows;
+    QBitArray m_cached[CachedColumnsCount];
+    QBitArray m_values[CachedColumnsCount];
 };
 
 inline bool MessagesModelCache::containsData(int row_idx) const {
-  return m_msgCache.contains(row_idx);
+  return row_idx >= 0 && row_idx < m_dirtyRows.size() && m_dirtyRows.testBit(row_idx);
+}
+
+inline bool MessagesModelCache::containsData(const QModelIndex& idx) const {
+  const int column = cachedColumn(idx.column());
+
+  return containsData(idx.row()) && column != NotCached && m_cached[column].testBit(idx.row());
 }
 
-inline QSqlRecord MessagesModelCache::record(int row_idx) const {
-  return m_msgCache.value(row_idx);
+inline bool MessagesModelCache::value(int row_idx, int column) const {
+  return m_values[cachedColumn(column)].testBit(row_idx);
 }
 
-inline void MessagesModelCache::clear() {
-  m_msgCache.clear();
+inline QVariant MessagesModelCache::data(const QModelIndex& idx) const {
+  return int(value(idx.row(), idx.column()));
 }
 
 #endif // MESSAGESMODELCACHE_H
@@ -5,7 +5,9 @@
 #include "definitions/definitions.h"
 #include "miscellaneous/application.h"
 
-MessagesModelSqlLayer::MessagesModelSqlLayer() : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)) {
+#include <QRegularExpression>
+
+MessagesModelSqlLayer::MessagesModelSqlLayer() : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)), m_showUnreadOnly(false) {
   m_db = qApp->database()->connection(QSL("MessagesModel"));
 
   // Used in <x>: SELECT <x1>, <x2> FROM ....;
@@ -18,7 +20,7 @@ MessagesModelSqlLayer::MessagesModelSqlLayer() : m_filter(QSL(DEFAULT_SQL_MESSAG
   m_fieldNames[MSG_DB_URL_INDEX] = "Messages.url";
   m_fieldNames[MSG_DB_AUTHOR_INDEX] = "Messages.author";
   m_fieldNames[MSG_DB_DCREATED_INDEX] = "Messages.date_created";
-  m_fieldNames[MSG_DB_CONTENTS_INDEX] = "Messages.contents";
+  m_fieldNames[MSG_DB_CONTENTS_INDEX] = QString("substr(Messages.contents, 1, %1) AS contents").arg(MSG_MODEL_CONTENTS_SNIPPET);
   m_fieldNames[MSG_DB_PDELETED_INDEX] = "Messages.is_pdeleted";
   m_fieldNames[MSG_DB_ENCLOSURES_INDEX] = "Messages.enclosures";
   m_fieldNames[MSG_DB_ACCOUNT_ID_INDEX] = "Messages.account_id";
@@ -78,6 +80,111 @@ void MessagesModelSqlLayer::addSortState(int column, Qt::SortOrder order) {
 
 void MessagesModelSqlLayer::setFilter(const QString& filter) {
   m_filter = filter;
+  m_keptMessageIds.clear();
+}
+
+void MessagesModelSqlLayer::setShowUnreadOnly(bool show_unread_only) {
+  if (m_showUnreadOnly != show_unread_only) {
+    m_showUnreadOnly = show_unread_only;
+    m_keptMessageIds.clear();
+  }
+}
+
+void MessagesModelSqlLayer::keepMessageVisible(int id) {
+  // NOTE: IDs are inlined into each query, so their count is limited.
+  if (m_showUnreadOnly && id > 0 && m_keptMessageIds.size() < MSG_MODEL_MAX_KEPT_MESSAGES) {
+    m_keptMessageIds.insert(id);
+  }
+}
+
+void MessagesModelSqlLayer::setSearchText(const QString& text) {
+  // NOTE: Only letters and digits are taken from the text, so
+  // special characters of full-text query syntax cannot be used
+  // and the text cannot break out of SQL string literal.
+  QRegularExpressionMatchIterator words = QRegularExpression(QSL("\\w+"),
+                                                             QRegularExpression::UseUnicodePropertiesOption).globalMatch(text);
+  QStringList terms;
+
+  while (words.hasNext()) {
+    terms.append(words.next().captured());
+  }
+
+  const bool full_text = qApp->database()->fullTextSearchAvailable();
+  const bool mysql = qApp->database()->activeDatabaseDriver() == DatabaseFactory::UsedDriver::MYSQL;
+  QStringList indexed_terms;
+  QStringList filters;
+
+  for (const QString& term : terms) {
+    if (full_text && (!mysql || isMysqlIndexedWord(term))) {
+      indexed_terms.append(term);
+    }
+    else {
+      filters.append(likeFilter(term));
+    }
+  }
+
+  if (!indexed_terms.isEmpty() && mysql) {
+    // Each word is required and is matched as prefix.
+    filters.prepend(QString(QSL("MATCH (Messages.title, Messages.author, Messages.contents) AGAINST ('+%1*' IN BOOLEAN MODE)"))
+                    .arg(indexed_terms.join(QSL("* +"))));
+  }
+  else if (!indexed_terms.isEmpty()) {
+    // Each word is quoted and matched as prefix, all words must be found.
+    filters.prepend(QString(QSL("Messages.id IN (SELECT rowid FROM MessagesFullText WHERE MessagesFullText MATCH '\"%1\"*')"))
+                    .arg(indexed_terms.join(QSL("\"* \""))));
+  }
+
+  m_searchFilter = filters.join(QSL(" AND "));
+}
+
+bool MessagesModelSqlLayer::isMysqlIndexedWord(const QString& word) const {
+  // Default stopwords of InnoDB full-text indexes.
+  static const QSet<QString> stopwords = {
+    QSL("a"), QSL("about"), QSL("an"), QSL("are"), QSL("as"), QSL("at"), QSL("be"), QSL("by"), QSL("com"),
+    QSL("de"), QSL("en"), QSL("for"), QSL("from"), QSL("how"), QSL("i"), QSL("in"), QSL("is"), QSL("it"),
+    QSL("la"), QSL("of"), QSL("on"), QSL("or"), QSL("that"), QSL("the"), QSL("this"), QSL("to"), QSL("was"),
+    QSL("what"), QSL("when"), QSL("where"), QSL("who"), QSL("will"), QSL("with"), QSL("und"), QSL("www")
+  };
+
+  // NOTE: MySQL does not index words shorter than "ft_min_word_len" (MyISAM)
+  // or "innodb_ft_min_token_size" (InnoDB) and required stopwords match nothing.
+  return word.size() >= MSG_SEARCH_MYSQL_MIN_WORD_LENGTH && !stopwords.contains(word.toLower());
+}
+
+QString MessagesModelSqlLayer::likeFilter(const QString& word) const {
+  // NOTE: Word contains only word characters and "_" is the only one of them
+  // with special meaning in LIKE pattern.
+  const QString pattern = QString(word).replace(QL1C('_'), QL1S("!_"));
+
+  return QString(QSL("(Messages.title LIKE '%%1%' ESCAPE '!' OR Messages.author LIKE '%%1%' ESCAPE '!' OR "
+                     "Messages.contents LIKE '%%1%' ESCAPE '!')")).arg(pattern);
+}
+
+QString MessagesModelSqlLayer::whereClause() const {
+  QString clause = m_filter;
+
+  if (!m_searchFilter.isEmpty()) {
+    clause = QL1C('(') + clause + QL1S(") AND ") + m_searchFilter;
+  }
+
+  if (m_showUnreadOnly) {
+    if (m_keptMessageIds.isEmpty()) {
+      clause = QL1C('(') + clause + QL1S(") AND Messages.is_read = 0");
+    }
+    else {
+      QStringList ids;
+
+      ids.reserve(m_keptMessageIds.size());
+
+      for (int id : m_keptMessageIds) {
+        ids.append(QString::number(id));
+      }
+
+      clause = QL1C('(') + clause + QL1S(") AND (Messages.is_read = 0 OR Messages.id IN (") + ids.join(QSL(", ")) + QL1S("))");
+    }
+  }
+
+  return clause;
 }
 
 QString MessagesModelSqlLayer::formatFields() const {
@@ -88,7 +195,41 @@ QString MessagesModelSqlLayer::selectStatement() const {
   return QL1S("SELECT ") + formatFields() + QL1C(' ') +
          QL1S("FROM Messages LEFT JOIN Feeds ON Messages.feed = Feeds.custom_id AND Messages.account_id = Feeds.account_id "
               "WHERE ") +
-         m_filter + orderByClause() + QL1C(';');
+         whereClause() + orderByClause() + QL1C(';');
+}
+
+QString MessagesModelSqlLayer::selectStatement(const QList<int>& ids) const {
+  QStringList id_list;
+
+  id_list.reserve(ids.size());
+
+  for (int id : ids) {
+    id_list.append(QString::number(id));
+  }
+
+  return QL1S("SELECT ") + formatFields() + QL1C(' ') +
+         QL1S("FROM Messages LEFT JOIN Feeds ON Messages.feed = Feeds.custom_id AND Messages.account_id = Feeds.account_id "
+              "WHERE Messages.id IN (") +
+         id_list.join(QSL(", ")) + QL1S(");");
+}
+
+QString MessagesModelSqlLayer::idStatement(int limit, int offset) const {
+  // NOTE: Messages.id is appended as last sort key, otherwise rows
+  // with equal sort values could swap places between windows.
+  const QString order_by = orderByClause();
+
+  return QL1S("SELECT Messages.id "
+              "FROM Messages LEFT JOIN Feeds ON Messages.feed = Feeds.custom_id AND Messages.account_id = Feeds.account_id "
+              "WHERE ") +
+         whereClause() +
+         (order_by.isEmpty() ? QSL(" ORDER BY Messages.id") : QString(order_by + QSL(", Messages.id"))) +
+         (limit < 0 ? QString() : QString(QSL(" LIMIT %1 OFFSET %2")).arg(QString::number(limit), QString::number(offset))) +
+         QL1C(';');
+}
+
+QString MessagesModelSqlLayer::countStatement() const {
+  // NOTE: Feeds table is not needed here, filters never use its columns.
+  return QL1S("SELECT COUNT(*) FROM Messages WHERE ") + whereClause() + QL1C(';');
 }
 
 QString MessagesModelSqlLayer::orderByClause() const {
@@ -7,6 +7,7 @@
 
 #include <QList>
 #include <QMap>
+#include <QSet>
 
 class MessagesModelSqlLayer {
   public:
@@ -18,15 +19,46 @@ class MessagesModelSqlLayer {
     // Sets SQL WHERE clause, without "WHERE" keyword.
     void setFilter(const QString& filter);
 
+    // Only messages which contain all words of given text in their title,
+    // author or contents are selected. Full-text index of DB is used for searching,
+    // words which cannot be found via the index are searched via LIKE.
+    void setSearchText(const QString& text);
+
+    // Only unread messages are selected if enabled. Messages which
+    // were marked read since filter was set are selected too, so that they
+    // do not disappear from the list right after user reads them.
+    // NOTE: Only limited number of read messages is kept in the list.
+    void setShowUnreadOnly(bool show_unread_only);
+    void keepMessageVisible(int id);
+
   protected:
     QString orderByClause() const;
     QString selectStatement() const;
+
+    // Returns statement which selects messages with given IDs
+    // regardless of current filter, order of rows is not defined.
+    QString selectStatement(const QList<int>& ids) const;
+
+    // Returns statement which selects only IDs of messages matching current filter, all
+    // of them if "limit" is negative. Rows are ordered deterministically even if sort
+    // values are equal, so that windows selected via "limit" and "offset" do not overlap.
+    QString idStatement(int limit = -1, int offset = 0) const;
+
+    // Returns statement which counts all messages matching current filter.
+    QString countStatement() const;
     QString formatFields() const;
 
     QSqlDatabase m_db;
 
   private:
+    QString whereClause() const;
+    bool isMysqlIndexedWord(const QString& word) const;
+    QString likeFilter(const QString& word) const;
+
     QString m_filter;
+    QString m_searchFilter;
+    bool m_showUnreadOnly;
+    QSet<int> m_keptMessageIds;
 
     // NOTE: These two lists contain data for multicolumn sorting.
     // They are always same length. Most important sort column/order
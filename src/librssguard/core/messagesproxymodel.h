@@ -26,6 +26,8 @@ class MessagesProxyModel : public QSortFilterProxyModel {
     // Performs sort of items.
     void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
 
+    // NOTE: Unread messages are filtered by DB, model
+    // must be repopulated to apply the change.
     bool showUnreadOnly() const;
     void setShowUnreadOnly(bool show_unread_only);
 
@@ -33,7 +35,6 @@ class MessagesProxyModel : public QSortFilterProxyModel {
     QModelIndex getNextUnreadItemIndex(int default_row, int max_row) const;
 
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const;
-    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const;
 
     // Source model pointer.
     MessagesModel* m_sourceModel;
@@ -21,9 +21,17 @@
 #define IS_IN_ARRAY(offset, array)            ((offset >= 0) && (offset < array.count()))
 #define ADBLOCK_CUSTOMLIST_NAME               "customlist.txt"
 #define ADBLOCK_LISTS_SUBDIRECTORY            "adblock"
+#define ADBLOCK_CACHE_SUFFIX                  ".cache"
+#define ADBLOCK_CACHE_VERSION                 1
 #define ADBLOCK_EASYLIST_URL                  "https://easylist-downloads.adblockplus.org/easylist.txt"
 #define DEFAULT_SQL_MESSAGES_FILTER           "0 > 1"
 #define MAX_MULTICOLUMN_SORT_STATES           3
+#define MSG_MODEL_PAGE_SIZE                   256
+#define MSG_MODEL_MAX_CACHED_PAGES            32
+#define MSG_MODEL_PREFETCH_MARGIN             64
+#define MSG_MODEL_CONTENTS_SNIPPET            256
+#define MSG_MODEL_MAX_KEPT_MESSAGES           500
+#define MSG_SEARCH_MYSQL_MIN_WORD_LENGTH      4
 #define ENCLOSURES_OUTER_SEPARATOR            '#'
 #define ECNLOSURES_INNER_SEPARATOR            '&'
 #define URI_SCHEME_FEED_SHORT                 "feed:"
@@ -47,7 +55,8 @@
 #define MESSAGES_VIEW_DEFAULT_COL             100
 #define MESSAGES_VIEW_MINIMUM_COL             16
 #define FEEDS_VIEW_COLUMN_COUNT               2
-#define FEED_DOWNLOADER_MAX_THREADS           3
+#define FEED_DOWNLOADER_MAX_THREADS           6
+#define FEED_DOWNLOADER_MAX_HOST_THREADS      2
 #define DEFAULT_DAYS_TO_DELETE_MSG            14
 #define ELLIPSIS_LENGTH                       3
 #define MIN_CATEGORY_NAME_LENGTH              1
@@ -57,6 +66,12 @@
 #define AUTO_UPDATE_INTERVAL                  60000
 #define STARTUP_UPDATE_DELAY                  15.0 // In seconds.
 #define TIMEZONE_OFFSET_LIMIT                 6
+#define HTML_ENTITY_MAX_LENGTH                32
+#define CACHE_FLUSH_CHUNK_SIZE                200
+#define CACHE_FLUSH_RETRIES                   3
+#define CACHE_FLUSH_RETRY_DELAY               1000 // In milliseconds.
+#define CACHE_JOURNAL_RECORD_READ_STATES      0
+#define CACHE_JOURNAL_RECORD_IMPORTANCES      1
 #define CHANGE_EVENT_DELAY                    250
 #define FLAG_ICON_SUBFOLDER                   "flags"
 #define SEACRH_MESSAGES_ACTION_NAME           "search"
@@ -113,15 +128,20 @@
 
 #define APP_DB_SQLITE_DRIVER          "QSQLITE"
 #define APP_DB_SQLITE_INIT            "db_init_sqlite.sql"
+#define APP_DB_SQLITE_FULLTEXT        "db_fulltext_sqlite.sql"
 #define APP_DB_SQLITE_PATH            "database/local"
 #define APP_DB_SQLITE_FILE            "database.db"
 
 // Keep this in sync with schema versions declared in SQL initialization code.
-#define APP_DB_SCHEMA_VERSION         "15"
+#define APP_DB_SCHEMA_VERSION         "22"
 #define APP_DB_UPDATE_FILE_PATTERN    "db_update_%1_%2_%3.sql"
 #define APP_DB_COMMENT_SPLIT          "-- !\n"
 #define APP_DB_NAME_PLACEHOLDER       "##"
 
+// Max. count of values bound into single "IN (...)" list, SQLite
+// allows only 999 bound parameters per statement by default.
+#define APP_DB_IN_CLAUSE_CHUNK_SIZE   500
+
 #define APP_CFG_PATH        "config"
 #define APP_CFG_FILE        "config.ini"
 
@@ -210,6 +230,9 @@
 #define FDS_DB_TYPE_INDEX             13
 #define FDS_DB_ACCOUNT_ID_INDEX       14
 #define FDS_DB_CUSTOM_ID_INDEX        15
+#define FDS_DB_HTTP_ETAG_INDEX        16
+#define FDS_DB_HTTP_LAST_MODIFIED_INDEX 17
+#define FDS_DB_CONTENTS_HASH_INDEX    18
 
 // Indexes of columns for feed models.
 #define FDS_MODEL_TITLE_INDEX           0
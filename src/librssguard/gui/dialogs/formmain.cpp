@@ -387,6 +387,26 @@ void FormMain::onFeedUpdatesProgress(const Feed* feed, int current, int total) {
                                  tr("Updated feed '%1'").arg(feed->title()));
 }
 
+void FormMain::onMessagesUpdateProgress(int done, int total) {
+  // Progress of running feed update has priority.
+  if (qApp->feedReader()->isFeedUpdateRunning()) {
+    return;
+  }
+
+  if (done < total) {
+    statusBar()->showProgressFeeds(int((done * 100.0) / total),
+
+                                   //: Text display in status bar when many messages are updated at once.
+                                   tr("Updated %1 of %2 messages").arg(done).arg(total));
+
+    // Messages are updated in main thread, so status bar must be redrawn now.
+    qApp->processEvents(QEventLoop::ExcludeUserInputEvents);
+  }
+  else {
+    statusBar()->clearProgressFeeds();
+  }
+}
+
 void FormMain::updateMessageButtonsAvailability() {
   const bool one_message_selected = tabWidget()->feedMessageViewer()->messagesView()->selectionModel()->selectedRows().size() == 1;
   const bool atleast_one_message_selected = !tabWidget()->feedMessageViewer()->messagesView()->selectionModel()->selectedRows().isEmpty();
@@ -684,6 +704,8 @@ void FormMain::createConnections() {
   connect(qApp->feedReader(), &FeedReader::feedUpdatesStarted, this, &FormMain::onFeedUpdatesStarted);
   connect(qApp->feedReader(), &FeedReader::feedUpdatesProgress, this, &FormMain::onFeedUpdatesProgress);
   connect(qApp->feedReader(), &FeedReader::feedUpdatesFinished, this, &FormMain::onFeedUpdatesFinished);
+  connect(tabWidget()->feedMessageViewer()->messagesView()->sourceModel(), &MessagesModel::messagesUpdateProgress,
+          this, &FormMain::onMessagesUpdateProgress);
 
   // Toolbar forwardings.
   connect(m_ui->m_actionAddFeedIntoSelectedAccount, &QAction::triggered,
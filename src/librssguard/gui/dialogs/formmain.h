@@ -64,6 +64,7 @@ class RSSGUARD_DLLSPEC FormMain : public QMainWindow {
     void onFeedUpdatesStarted();
     void onFeedUpdatesProgress(const Feed* feed, int current, int total);
     void onFeedUpdatesFinished(const FeedDownloadResults& results);
+    void onMessagesUpdateProgress(int done, int total);
 
     // Displays various dialogs.
     void backupDatabaseSettings();
@@ -84,39 +84,54 @@ void MessagesView::reloadSelections() {
   const QDateTime dt1 = QDateTime::currentDateTime();
   QModelIndex current_index = selectionModel()->currentIndex();
   const QModelIndex mapped_current_index = m_proxyModel->mapToSource(current_index);
-  const Message selected_message = m_sourceModel->messageAt(mapped_current_index.row());
+  const int selected_message_id = m_sourceModel->messageId(mapped_current_index.row());
   const int col = header()->sortIndicatorSection();
   const Qt::SortOrder ord = header()->sortIndicatorOrder();
+  QList<int> other_selected_messages;
+
+  // Remember IDs of other selected messages too.
+  const QModelIndexList selected_rows = selectionModel()->selectedRows();
+
+  if (selected_rows.size() < RESELECT_MESSAGE_THRESSHOLD) {
+    for (const QModelIndex& selected_row : selected_rows) {
+      const int source_row = m_proxyModel->mapToSource(selected_row).row();
+      const int message_id = m_sourceModel->messageId(source_row);
+
+      if (message_id > 0 && message_id != selected_message_id) {
+        other_selected_messages.append(message_id);
+      }
+    }
+  }
 
   // Reload the model now.
   sort(col, ord, true, false, false);
 
   // Now, we must find the same previously focused message.
-  if (selected_message.m_id > 0) {
-    if (m_proxyModel->rowCount() == 0) {
-      current_index = QModelIndex();
-    }
-    else {
-      for (int i = 0; i < m_proxyModel->rowCount(); i++) {
-        QModelIndex msg_idx = m_proxyModel->index(i, MSG_DB_TITLE_INDEX);
-        Message msg = m_sourceModel->messageAt(m_proxyModel->mapToSource(msg_idx).row());
-
-        if (msg.m_id == selected_message.m_id) {
-          current_index = msg_idx;
-          break;
-        }
+  if (selected_message_id > 0) {
+    const int source_row = m_sourceModel->rowForMessageId(selected_message_id);
 
-        if (i == m_proxyModel->rowCount() - 1) {
-          current_index = QModelIndex();
-        }
-      }
-    }
+    current_index = source_row < 0 ?
+                    QModelIndex() :
+                    m_proxyModel->mapFromSource(m_sourceModel->index(source_row, MSG_DB_TITLE_INDEX));
   }
 
   if (current_index.isValid()) {
+    QModelIndexList reselected_indexes;
+
+    reselected_indexes << current_index;
+
+    for (int other_message_id : other_selected_messages) {
+      const int source_row = m_sourceModel->rowForMessageId(other_message_id);
+      const QModelIndex other_index = m_proxyModel->mapFromSource(m_sourceModel->index(source_row, MSG_DB_TITLE_INDEX));
+
+      if (other_index.isValid()) {
+        reselected_indexes << other_index;
+      }
+    }
+
     scrollTo(current_index);
     setCurrentIndex(current_index);
-    reselectIndexes(QModelIndexList() << current_index);
+    reselectIndexes(reselected_indexes);
   }
   else {
     // Messages were probably removed from the model, nothing can
@@ -235,7 +250,7 @@ void MessagesView::mousePressEvent(QMouseEvent* event) {
 
         if (mapped_index.column() == MSG_DB_IMPORTANT_INDEX) {
           if (m_sourceModel->switchMessageImportance(mapped_index.row())) {
-            emit currentMessageChanged(m_sourceModel->messageAt(mapped_index.row()), m_sourceModel->loadedItem());
+            emit currentMessageChanged(m_sourceModel->fullMessageAt(mapped_index.row()), m_sourceModel->loadedItem());
           }
         }
       }
@@ -281,7 +296,7 @@ void MessagesView::selectionChanged(const QItemSelection& selected, const QItemS
          mapped_current_index.column());
 
   if (mapped_current_index.isValid() && selected_rows.count() > 0) {
-    Message message = m_sourceModel->messageAt(m_proxyModel->mapToSource(current_index).row());
+    Message message = m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(current_index).row());
 
     // Set this message as read only if current item
     // wasn't changed by "mark selected messages unread" action.
@@ -346,7 +361,7 @@ void MessagesView::openSelectedMessagesInternally() {
   QList<Message> messages;
 
   for (const QModelIndex& index : selectionModel()->selectedRows()) {
-    messages << m_sourceModel->messageAt(m_proxyModel->mapToSource(index).row());
+    messages << m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(index).row());
   }
 
   if (!messages.isEmpty()) {
@@ -356,7 +371,7 @@ void MessagesView::openSelectedMessagesInternally() {
 
 void MessagesView::sendSelectedMessageViaEmail() {
   if (selectionModel()->selectedRows().size() == 1) {
-    const Message message = m_sourceModel->messageAt(m_proxyModel->mapToSource(selectionModel()->selectedRows().at(0)).row());
+    const Message message = m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(selectionModel()->selectedRows().at(0)).row());
 
     if (!qApp->web()->sendMessageViaEmail(message)) {
       MessageBox::show(this, QMessageBox::Critical, tr("Problem with starting external e-mail client"),
@@ -387,7 +402,7 @@ void MessagesView::setSelectedMessagesReadStatus(RootItem::ReadStatus read) {
   current_index = m_proxyModel->index(current_index.row(), current_index.column());
 
   if (current_index.isValid()) {
-    emit currentMessageChanged(m_sourceModel->messageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
+    emit currentMessageChanged(m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
   }
   else {
     emit currentMessageRemoved();
@@ -410,7 +425,7 @@ void MessagesView::deleteSelectedMessages() {
   if (current_index.isValid()) {
     setCurrentIndex(current_index);
 
-    emit currentMessageChanged(m_sourceModel->messageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
+    emit currentMessageChanged(m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
   }
   else {
     emit currentMessageRemoved();
@@ -431,7 +446,7 @@ void MessagesView::restoreSelectedMessages() {
   current_index = m_proxyModel->index(current_index.row(), current_index.column());
 
   if (current_index.isValid()) {
-    emit currentMessageChanged(m_sourceModel->messageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
+    emit currentMessageChanged(m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
   }
   else {
     emit currentMessageRemoved();
@@ -452,7 +467,7 @@ void MessagesView::switchSelectedMessagesImportance() {
   current_index = m_proxyModel->index(current_index.row(), current_index.column());
 
   if (current_index.isValid()) {
-    emit currentMessageChanged(m_sourceModel->messageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
+    emit currentMessageChanged(m_sourceModel->fullMessageAt(m_proxyModel->mapToSource(current_index).row()), m_sourceModel->loadedItem());
   }
   else {
     // Messages were probably removed from the model, nothing can
@@ -516,15 +531,10 @@ void MessagesView::selectNextUnreadItem() {
 }
 
 void MessagesView::searchMessages(const QString& pattern) {
-  m_proxyModel->setFilterRegExp(pattern);
-
-  if (selectionModel()->selectedRows().isEmpty()) {
-    emit currentMessageRemoved();
-  }
-  else {
-    // Scroll to selected message, it could become scrolled out due to filter change.
-    scrollTo(selectionModel()->selectedRows().at(0));
-  }
+  // Messages are searched in DB, selected message
+  // stays selected if it matches the pattern.
+  m_sourceModel->setSearchText(pattern);
+  reloadSelections();
 }
 
 void MessagesView::filterMessages(MessagesModel::MessageHighlighter filter) {
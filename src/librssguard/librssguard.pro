@@ -29,7 +29,8 @@ RESOURCES += ../../resources/sql.qrc \
              ../../resources/rssguard.qrc \
              ../../resources/icons.qrc
 
-HEADERS += core/feeddownloader.h \
+HEADERS += core/duplicatemessageindex.h \
+           core/feeddownloader.h \
            core/feedsmodel.h \
            core/feedsproxymodel.h \
            core/message.h \
@@ -37,6 +38,7 @@ HEADERS += core/feeddownloader.h \
            core/messagesmodel.h \
            core/messagesmodelcache.h \
            core/messagesmodelsqllayer.h \
+           core/messagesanitizer.h \
            core/messagesproxymodel.h \
            definitions/definitions.h \
            dynamic-shortcuts/dynamicshortcuts.h \
@@ -113,6 +115,7 @@ HEADERS += core/feeddownloader.h \
            network-web/basenetworkaccessmanager.h \
            network-web/downloader.h \
            network-web/downloadmanager.h \
+           network-web/htmlentities.h \
            network-web/networkfactory.h \
            network-web/oauth2service.h \
            network-web/silentnetworkaccessmanager.h \
@@ -131,6 +134,7 @@ HEADERS += core/feeddownloader.h \
            services/abstract/rootitem.h \
            services/abstract/serviceentrypoint.h \
            services/abstract/serviceroot.h \
+           services/abstract/syncforserviceroot.h \
            services/gmail/definitions.h \
            services/gmail/gmailentrypoint.h \
            services/gmail/gmailfeed.h \
@@ -153,6 +157,7 @@ HEADERS += core/feeddownloader.h \
            services/owncloud/owncloudserviceroot.h \
            services/standard/atomparser.h \
            services/standard/feedparser.h \
+           services/standard/feedstreamparser.h \
            services/standard/gui/formstandardcategorydetails.h \
            services/standard/gui/formstandardfeeddetails.h \
            services/standard/gui/formstandardimportexport.h \
@@ -176,7 +181,8 @@ HEADERS += core/feeddownloader.h \
            gui/searchtextwidget.h \
            network-web/oauthhttphandler.h
 
-SOURCES += core/feeddownloader.cpp \
+SOURCES += core/duplicatemessageindex.cpp \
+           core/feeddownloader.cpp \
            core/feedsmodel.cpp \
            core/feedsproxymodel.cpp \
            core/message.cpp \
@@ -184,6 +190,7 @@ SOURCES += core/feeddownloader.cpp \
            core/messagesmodel.cpp \
            core/messagesmodelcache.cpp \
            core/messagesmodelsqllayer.cpp \
+           core/messagesanitizer.cpp \
            core/messagesproxymodel.cpp \
            dynamic-shortcuts/dynamicshortcuts.cpp \
            dynamic-shortcuts/dynamicshortcutswidget.cpp \
@@ -258,6 +265,7 @@ SOURCES += core/feeddownloader.cpp \
            network-web/basenetworkaccessmanager.cpp \
            network-web/downloader.cpp \
            network-web/downloadmanager.cpp \
+           network-web/htmlentities.cpp \
            network-web/networkfactory.cpp \
            network-web/oauth2service.cpp \
            network-web/silentnetworkaccessmanager.cpp \
@@ -276,6 +284,7 @@ SOURCES += core/feeddownloader.cpp \
            services/abstract/rootitem.cpp \
            services/abstract/serviceentrypoint.cpp \
            services/abstract/serviceroot.cpp \
+           services/abstract/syncforserviceroot.cpp \
            services/gmail/gmailentrypoint.cpp \
            services/gmail/gmailfeed.cpp \
            services/gmail/gmailserviceroot.cpp \
@@ -295,6 +304,7 @@ SOURCES += core/feeddownloader.cpp \
            services/owncloud/owncloudserviceroot.cpp \
            services/standard/atomparser.cpp \
            services/standard/feedparser.cpp \
+           services/standard/feedstreamparser.cpp \
            services/standard/gui/formstandardcategorydetails.cpp \
            services/standard/gui/formstandardfeeddetails.cpp \
            services/standard/gui/formstandardimportexport.cpp \
@@ -376,6 +386,7 @@ equals(USE_WEBENGINE, true) {
              network-web/adblock/adblockmanager.h \
              network-web/adblock/adblockmatcher.h \
              network-web/adblock/adblockrule.h \
+             network-web/adblock/adblockruleindex.h \
              network-web/adblock/adblocksearchtree.h \
              network-web/adblock/adblocksubscription.h \
              network-web/adblock/adblocktreewidget.h \
@@ -390,6 +401,7 @@ equals(USE_WEBENGINE, true) {
              network-web/adblock/adblockmanager.cpp \
              network-web/adblock/adblockmatcher.cpp \
              network-web/adblock/adblockrule.cpp \
+             network-web/adblock/adblockruleindex.cpp \
              network-web/adblock/adblocksearchtree.cpp \
              network-web/adblock/adblocksubscription.cpp \
              network-web/adblock/adblocktreewidget.cpp \
@@ -17,7 +17,8 @@ DatabaseFactory::DatabaseFactory(QObject* parent)
   m_activeDatabaseDriver(UsedDriver::SQLITE),
   m_mysqlDatabaseInitialized(false),
   m_sqliteFileBasedDatabaseInitialized(false),
-  m_sqliteInMemoryDatabaseInitialized(false) {
+  m_sqliteInMemoryDatabaseInitialized(false),
+  m_sqliteFullTextSearchAvailable(false) {
   setObjectName(QSL("DatabaseFactory"));
   determineDriver();
 }
@@ -244,6 +245,9 @@ QSqlDatabase DatabaseFactory::sqliteInitializeInMemoryDatabase() {
       qDebug("In-memory SQLite database has version '%s'.", qPrintable(query_db.value(0).toString()));
     }
 
+    // NOTE: Index must exist before messages are copied, it is filled by triggers.
+    sqliteSetupFullTextSearch(database);
+
     // Loading messages from file-based database.
     QSqlDatabase file_database = sqliteConnection(objectName(), DesiredType::StrictlyFileBased);
     QSqlQuery copy_contents(database);
@@ -254,7 +258,8 @@ QSqlDatabase DatabaseFactory::sqliteInitializeInMemoryDatabase() {
     // Copy all stuff.
     QStringList tables;
 
-    if (copy_contents.exec(QSL("SELECT name FROM storage.sqlite_master WHERE type='table';"))) {
+    // NOTE: Full-text index is not copied, it is filled by triggers when messages are copied.
+    if (copy_contents.exec(QSL("SELECT name FROM storage.sqlite_master WHERE type='table' AND name NOT LIKE 'MessagesFullText%';"))) {
       while (copy_contents.next()) {
         tables.append(copy_contents.value(0).toString());
       }
@@ -378,6 +383,8 @@ QSqlDatabase DatabaseFactory::sqliteInitializeFileBasedDatabase(const QString& c
              qPrintable(QDir::toNativeSeparators(database.databaseName())));
       qDebug("File-based SQLite database has version '%s'.", qPrintable(installed_db_schema));
     }
+
+    sqliteSetupFullTextSearch(database);
   }
 
   // Everything is initialized now.
@@ -389,6 +396,64 @@ QString DatabaseFactory::sqliteDatabaseFilePath() const {
   return m_sqliteDatabaseFilePath + QDir::separator() + APP_DB_SQLITE_FILE;
 }
 
+void DatabaseFactory::sqliteSetupFullTextSearch(const QSqlDatabase& database) {
+  QSqlQuery query_db(database);
+
+  query_db.setForwardOnly(true);
+
+  // FTS5 is optional part of SQLite, so we check if its table can be created.
+  if (!query_db.exec(QSL("CREATE VIRTUAL TABLE temp.MessagesFullTextTest USING fts5(contents);"))) {
+    qWarning("SQLite does not support FTS5, messages will be searched without full-text index: '%s'.",
+             qPrintable(query_db.lastError().text()));
+
+    // DB could be created by SQLite with FTS5, its triggers would break storing of messages.
+    query_db.exec(QSL("DROP TRIGGER IF EXISTS trg_Messages_fulltext_insert;"));
+    query_db.exec(QSL("DROP TRIGGER IF EXISTS trg_Messages_fulltext_delete;"));
+    query_db.exec(QSL("DROP TRIGGER IF EXISTS trg_Messages_fulltext_update;"));
+    m_sqliteFullTextSearchAvailable = false;
+    return;
+  }
+
+  query_db.exec(QSL("DROP TABLE temp.MessagesFullTextTest;"));
+
+  if (query_db.exec(QSL("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'MessagesFullText';")) && query_db.next()) {
+    // Index is already created and kept up to date by triggers.
+    m_sqliteFullTextSearchAvailable = true;
+    return;
+  }
+
+  QFile file_fulltext(APP_SQL_PATH + QDir::separator() + APP_DB_SQLITE_FULLTEXT);
+
+  if (!file_fulltext.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qCritical("SQLite full-text index script '%s' was not found.", APP_DB_SQLITE_FULLTEXT);
+    m_sqliteFullTextSearchAvailable = false;
+    return;
+  }
+
+  const QStringList statements = QString(file_fulltext.readAll()).split(APP_DB_COMMENT_SPLIT,
+#if QT_VERSION >= 0x050F00 // Qt >= 5.15.0
+                                                                        Qt::SplitBehaviorFlags::SkipEmptyParts);
+#else
+                                                                        QString::SkipEmptyParts);
+#endif
+  QSqlDatabase db(database);
+
+  // Index is built from existing messages.
+  db.transaction();
+
+  for (const QString& statement : statements) {
+    if (!query_db.exec(statement)) {
+      qCritical("Creation of SQLite full-text index failed: '%s'.", qPrintable(query_db.lastError().text()));
+      db.rollback();
+      m_sqliteFullTextSearchAvailable = false;
+      return;
+    }
+  }
+
+  m_sqliteFullTextSearchAvailable = db.commit();
+  qDebug("SQLite full-text index of messages was created.");
+}
+
 bool DatabaseFactory::sqliteUpdateDatabaseSchema(const QSqlDatabase& database, const QString& source_db_schema_version) {
   int working_version = QString(source_db_schema_version).remove('.').toInt();
   const int current_version = QString(APP_DB_SCHEMA_VERSION).remove('.').toInt();
@@ -548,7 +613,8 @@ void DatabaseFactory::sqliteSaveMemoryDatabase() {
   // Copy all stuff.
   QStringList tables;
 
-  if (copy_contents.exec(QSL("SELECT name FROM storage.sqlite_master WHERE type='table';"))) {
+  // NOTE: Full-text index is not copied, it is filled by triggers when messages are copied.
+  if (copy_contents.exec(QSL("SELECT name FROM storage.sqlite_master WHERE type='table' AND name NOT LIKE 'MessagesFullText%';"))) {
     while (copy_contents.next()) {
       tables.append(copy_contents.value(0).toString());
     }
@@ -616,6 +682,10 @@ DatabaseFactory::UsedDriver DatabaseFactory::activeDatabaseDriver() const {
   return m_activeDatabaseDriver;
 }
 
+bool DatabaseFactory::fullTextSearchAvailable() const {
+  return m_activeDatabaseDriver == UsedDriver::MYSQL || m_sqliteFullTextSearchAvailable;
+}
+
 QSqlDatabase DatabaseFactory::mysqlConnection(const QString& connection_name) {
   if (!m_mysqlDatabaseInitialized) {
     // Return initialized database.
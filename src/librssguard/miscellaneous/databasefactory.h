@@ -75,6 +75,11 @@ class DatabaseFactory : public QObject {
     // Returns identification of currently active database driver.
     UsedDriver activeDatabaseDriver() const;
 
+    // Returns true if DB has full-text index of messages.
+    // NOTE: SQLite can be built without FTS5, messages
+    // are then searched without the index.
+    bool fullTextSearchAvailable() const;
+
     // Copies selected backup database (file) to active database path.
     bool initiateRestoration(const QString& database_backup_file_path);
 
@@ -156,12 +161,16 @@ class DatabaseFactory : public QObject {
     QSqlDatabase sqliteInitializeInMemoryDatabase();
     QSqlDatabase sqliteInitializeFileBasedDatabase(const QString& connection_name);
 
+    // Creates full-text index of messages if SQLite supports FTS5.
+    void sqliteSetupFullTextSearch(const QSqlDatabase& database);
+
     // Path to database file.
     QString m_sqliteDatabaseFilePath;
 
     // Is database file initialized?
     bool m_sqliteFileBasedDatabaseInitialized;
     bool m_sqliteInMemoryDatabaseInitialized;
+    bool m_sqliteFullTextSearchAvailable;
 };
 
 #endif // DATABASEFACTORY_H
@@ -4,6 +4,7 @@
 
 #include "exceptions/applicationexception.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/textfactory.h"
 #include "network-web/oauth2service.h"
@@ -27,6 +28,7 @@
 #include "services/tt-rss/ttrssfeed.h"
 #include "services/tt-rss/ttrssserviceroot.h"
 
+#include <QSet>
 #include <QSqlDriver>
 #include <QUrl>
 #include <QVariant>
@@ -42,12 +44,10 @@ bool DatabaseQueries::markImportantMessagesReadUnread(const QSqlDatabase& db, in
   return q.exec();
 }
 
-bool DatabaseQueries::markMessagesReadUnread(const QSqlDatabase& db, const QStringList& ids, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  return q.exec(QString(QSL("UPDATE Messages SET is_read = %2 WHERE id IN (%1);"))
-                .arg(ids.join(QSL(", ")), read == RootItem::Read ? QSL("1") : QSL("0")));
+bool DatabaseQueries::markMessagesReadUnread(const QSqlDatabase& db, const QStringList& ids, RootItem::ReadStatus read,
+                                             const std::function<void(int, int)>& progress) {
+  return updateMessagesByIds(db, QSL("UPDATE Messages SET is_read = ? WHERE id IN (%1);"),
+                             ids, QVariantList() << (read == RootItem::Read ? 1 : 0), progress);
 }
 
 bool DatabaseQueries::markMessageImportant(const QSqlDatabase& db, int id, RootItem::Importance importance) {
@@ -99,27 +99,21 @@ bool DatabaseQueries::markAccountReadUnread(const QSqlDatabase& db, int account_
   return q.exec();
 }
 
-bool DatabaseQueries::switchMessagesImportance(const QSqlDatabase& db, const QStringList& ids) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  return q.exec(QString(QSL("UPDATE Messages SET is_important = NOT is_important WHERE id IN (%1);")).arg(ids.join(QSL(", "))));
+bool DatabaseQueries::switchMessagesImportance(const QSqlDatabase& db, const QStringList& ids,
+                                               const std::function<void(int, int)>& progress) {
+  return updateMessagesByIds(db, QSL("UPDATE Messages SET is_important = NOT is_important WHERE id IN (%1);"),
+                             ids, QVariantList(), progress);
 }
 
-bool DatabaseQueries::permanentlyDeleteMessages(const QSqlDatabase& db, const QStringList& ids) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  return q.exec(QString(QSL("UPDATE Messages SET is_pdeleted = 1 WHERE id IN (%1);")).arg(ids.join(QSL(", "))));
+bool DatabaseQueries::permanentlyDeleteMessages(const QSqlDatabase& db, const QStringList& ids,
+                                                const std::function<void(int, int)>& progress) {
+  return updateMessagesByIds(db, QSL("UPDATE Messages SET is_pdeleted = 1 WHERE id IN (%1);"), ids, QVariantList(), progress);
 }
 
-bool DatabaseQueries::deleteOrRestoreMessagesToFromBin(const QSqlDatabase& db, const QStringList& ids, bool deleted) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  return q.exec(QString(QSL("UPDATE Messages SET is_deleted = %2, is_pdeleted = %3 WHERE id IN (%1);")).arg(ids.join(QSL(", ")),
-                                                                                                            QString::number(deleted ? 1 : 0),
-                                                                                                            QString::number(0)));
+bool DatabaseQueries::deleteOrRestoreMessagesToFromBin(const QSqlDatabase& db, const QStringList& ids, bool deleted,
+                                                       const std::function<void(int, int)>& progress) {
+  return updateMessagesByIds(db, QSL("UPDATE Messages SET is_deleted = ?, is_pdeleted = 0 WHERE id IN (%1);"),
+                             ids, QVariantList() << (deleted ? 1 : 0), progress);
 }
 
 bool DatabaseQueries::restoreBin(const QSqlDatabase& db, int account_id) {
@@ -378,6 +372,29 @@ int DatabaseQueries::getMessageCountsForBin(const QSqlDatabase& db, int account_
   }
 }
 
+QString DatabaseQueries::getMessageContents(const QSqlDatabase& db, int message_id, bool* ok) {
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT contents FROM Messages WHERE id = :id;"));
+  q.bindValue(QSL(":id"), message_id);
+
+  if (q.exec() && q.next()) {
+    if (ok != nullptr) {
+      *ok = true;
+    }
+
+    return q.value(0).toString();
+  }
+  else {
+    if (ok != nullptr) {
+      *ok = false;
+    }
+
+    return QString();
+  }
+}
+
 QList<Message> DatabaseQueries::getUndeletedImportantMessages(const QSqlDatabase& db, int account_id, bool* ok) {
   QList<Message> messages;
   QSqlQuery q(db);
@@ -518,6 +535,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
                                     int account_id,
                                     const QString& url,
                                     bool* any_message_changed,
+                                    MessageCountsDelta* counts_delta,
                                     bool* ok) {
   if (messages.isEmpty()) {
     *any_message_changed = false;
@@ -530,46 +548,12 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
   // Does not make any difference, since each feed now has
   // its own "custom ID" (standard feeds have their custom ID equal to primary key ID).
   int updated_messages = 0;
+  QList<Message> fixed_messages;
+  QStringList custom_ids;
+  QStringList urls;
+  const bool case_insensitive = db.driverName() == APP_DB_MYSQL_DRIVER;
 
-  // Prepare queries.
-  QSqlQuery query_select_with_url(db);
-  QSqlQuery query_select_with_id(db);
-  QSqlQuery query_update(db);
-  QSqlQuery query_insert(db);
-  QSqlQuery query_begin_transaction(db);
-
-  // Here we have query which will check for existence of the "same" message in given feed.
-  // The two message are the "same" if:
-  //   1) they belong to the SAME FEED AND,
-  //   2) they have same URL AND,
-  //   3) they have same AUTHOR AND,
-  //   4) they have same TITLE.
-  query_select_with_url.setForwardOnly(true);
-  query_select_with_url.prepare("SELECT id, date_created, is_read, is_important, contents, feed FROM Messages "
-                                "WHERE feed = :feed AND title = :title AND url = :url AND author = :author AND account_id = :account_id;");
-
-  // When we have custom ID of the message, we can check directly for existence
-  // of that particular message.
-  query_select_with_id.setForwardOnly(true);
-  query_select_with_id.prepare("SELECT id, date_created, is_read, is_important, contents, feed FROM Messages "
-                               "WHERE custom_id = :custom_id AND account_id = :account_id;");
-
-  // Used to insert new messages.
-  query_insert.setForwardOnly(true);
-  query_insert.prepare("INSERT INTO Messages "
-                       "(feed, title, is_read, is_important, url, author, date_created, contents, enclosures, custom_id, custom_hash, account_id) "
-                       "VALUES (:feed, :title, :is_read, :is_important, :url, :author, :date_created, :contents, :enclosures, :custom_id, :custom_hash, :account_id);");
-
-  // Used to update existing messages.
-  query_update.setForwardOnly(true);
-  query_update.prepare("UPDATE Messages "
-                       "SET title = :title, is_read = :is_read, is_important = :is_important, url = :url, author = :author, date_created = :date_created, contents = :contents, enclosures = :enclosures, feed = :feed "
-                       "WHERE id = :id;");
-
-  if (use_transactions && !query_begin_transaction.exec(qApp->database()->obtainBeginTransactionSql())) {
-    qCritical("Transaction start for message downloader failed: '%s'.", qPrintable(query_begin_transaction.lastError().text()));
-    return updated_messages;
-  }
+  fixed_messages.reserve(messages.size());
 
   for (Message message : messages) {
     // Check if messages contain relative URLs and if they do, then replace them.
@@ -587,149 +571,239 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
       message.m_url = new_message_url;
     }
 
-    int id_existing_message = -1;
-    qint64 date_existing_message;
-    bool is_read_existing_message;
-    bool is_important_existing_message;
-    QString contents_existing_message;
-    QString feed_id_existing_message;
+    fixed_messages.append(message);
+  }
+
+  fixed_messages = uniqueMessages(fixed_messages, case_insensitive);
 
+  for (const Message& message : fixed_messages) {
     if (message.m_customId.isEmpty()) {
-      // We need to recognize existing messages according URL & AUTHOR & TITLE.
-      // NOTE: This particularly concerns messages from standard account.
-      query_select_with_url.bindValue(QSL(":feed"), unnulifyString(feed_custom_id));
-      query_select_with_url.bindValue(QSL(":title"), unnulifyString(message.m_title));
-      query_select_with_url.bindValue(QSL(":url"), unnulifyString(message.m_url));
-      query_select_with_url.bindValue(QSL(":author"), unnulifyString(message.m_author));
-      query_select_with_url.bindValue(QSL(":account_id"), account_id);
-
-      qDebug("Checking if message with title '%s', url '%s' and author '%s' is present in DB.",
-             qPrintable(message.m_title), qPrintable(message.m_url), qPrintable(message.m_author));
-
-      if (query_select_with_url.exec() && query_select_with_url.next()) {
-        id_existing_message = query_select_with_url.value(0).toInt();
-        date_existing_message = query_select_with_url.value(1).value<qint64>();
-        is_read_existing_message = query_select_with_url.value(2).toBool();
-        is_important_existing_message = query_select_with_url.value(3).toBool();
-        contents_existing_message = query_select_with_url.value(4).toString();
-        feed_id_existing_message = query_select_with_url.value(5).toString();
-
-        qDebug("Message with these attributes is already present in DB and has DB ID %d.", id_existing_message);
-      }
-      else if (query_select_with_url.lastError().isValid()) {
-        qWarning("Failed to check for existing message in DB via URL: '%s'.", qPrintable(query_select_with_url.lastError().text()));
-      }
+      urls.append(unnulifyString(message.m_url));
+    }
+    else {
+      custom_ids.append(message.m_customId);
+    }
+  }
+
+  QSqlQuery query_begin_transaction(db);
+
+  if (use_transactions && !query_begin_transaction.exec(qApp->database()->obtainBeginTransactionSql())) {
+    qCritical("Transaction start for message downloader failed: '%s'.", qPrintable(query_begin_transaction.lastError().text()));
+    return updated_messages;
+  }
 
-      query_select_with_url.finish();
+  // Here we find out which messages are already present in DB, all of them at once.
+  // The two message are the "same" if:
+  //   1) they have same custom ID (messages from custom accounts, like TT-RSS or Nextcloud News) OR,
+  //   2) they belong to the SAME FEED AND have same URL AND same AUTHOR AND same TITLE
+  //      (messages from standard account).
+  bool lookup_ok = true;
+  const QHash<QString, Message> existing_by_id = custom_ids.isEmpty()
+                                                 ? QHash<QString, Message>()
+                                                 : existingMessagesByCustomId(db, custom_ids, account_id, case_insensitive, &lookup_ok);
+  const QHash<QString, Message> existing_by_url = (!lookup_ok || urls.isEmpty())
+                                                  ? QHash<QString, Message>()
+                                                  : existingMessagesByUrl(db, feed_custom_id, urls, account_id, case_insensitive, &lookup_ok);
+
+  if (!lookup_ok) {
+    // We cannot tell new messages from existing ones, so
+    // we rather do nothing than create duplicates.
+    if (use_transactions) {
+      db.rollback();
+    }
+
+    if (ok != nullptr) {
+      *ok = false;
+    }
+
+    return 0;
+  }
+
+  QVariantList ins_feeds, ins_titles, ins_reads, ins_importants, ins_urls, ins_authors,
+               ins_dates, ins_contents, ins_enclosures, ins_custom_ids, ins_custom_hashes, ins_account_ids;
+  QVariantList upd_titles, upd_reads, upd_importants, upd_urls, upd_authors,
+               upd_dates, upd_contents, upd_enclosures, upd_feeds, upd_ids;
+  bool fixup_custom_ids = false;
+  int updated_unread_messages = 0;
+  MessageCountsDelta upd_counts_delta, ins_counts_delta;
+  QList<Message> upd_messages, ins_messages;
+
+  for (const Message& message : fixed_messages) {
+    Message existing_message;
+    bool exists;
+
+    if (message.m_customId.isEmpty()) {
+      const QString url_key = messageUrlKey(message.m_title, message.m_url, message.m_author, case_insensitive);
+
+      exists = existing_by_url.contains(url_key);
+      existing_message = existing_by_url.value(url_key);
     }
     else {
-      // We can recognize existing messages via their custom ID.
-      // NOTE: This concerns messages from custom accounts, like TT-RSS or Nextcloud News.
-      query_select_with_id.bindValue(QSL(":account_id"), account_id);
-      query_select_with_id.bindValue(QSL(":custom_id"), unnulifyString(message.m_customId));
-
-      qDebug("Checking if message with custom ID %s is present in DB.", qPrintable(message.m_customId));
-
-      if (query_select_with_id.exec() && query_select_with_id.next()) {
-        id_existing_message = query_select_with_id.value(0).toInt();
-        date_existing_message = query_select_with_id.value(1).value<qint64>();
-        is_read_existing_message = query_select_with_id.value(2).toBool();
-        is_important_existing_message = query_select_with_id.value(3).toBool();
-        contents_existing_message = query_select_with_id.value(4).toString();
-        feed_id_existing_message = query_select_with_id.value(5).toString();
-
-        qDebug("Message with custom ID %s is already present in DB and has DB ID %d.",
-               qPrintable(message.m_customId), id_existing_message);
-      }
-      else if (query_select_with_id.lastError().isValid()) {
-        qDebug("Failed to check for existing message in DB via ID: '%s'.", qPrintable(query_select_with_id.lastError().text()));
-      }
+      const QString id_key = messageIdKey(message.m_customId, case_insensitive);
 
-      query_select_with_id.finish();
+      exists = existing_by_id.contains(id_key);
+      existing_message = existing_by_id.value(id_key);
     }
 
     // Now, check if this message is already in the DB.
-    if (id_existing_message >= 0) {
+    if (exists) {
       // Message is already in the DB.
       //
       // Now, we update it if at least one of next conditions is true:
       //   1) Message has custom ID AND (its date OR read status OR starred status are changed).
       //   2) Message has its date fetched from feed AND its date is different from date in DB and contents is changed.
+      const qint64 date_existing_message = existing_message.m_created.toMSecsSinceEpoch();
+
       if (/* 1 */ (!message.m_customId.isEmpty() && (message.m_created.toMSecsSinceEpoch() != date_existing_message ||
-                                                     message.m_isRead != is_read_existing_message ||
-                                                     message.m_isImportant != is_important_existing_message ||
-                                                     message.m_feedId != feed_id_existing_message)) ||
+                                                     message.m_isRead != existing_message.m_isRead ||
+                                                     message.m_isImportant != existing_message.m_isImportant ||
+                                                     message.m_feedId != existing_message.m_feedId)) ||
 
           /* 2 */ (message.m_createdFromFeed && message.m_created.toMSecsSinceEpoch() != date_existing_message
-                   && message.m_contents != contents_existing_message)) {
+                   && message.m_contents != existing_message.m_contents)) {
         // Message exists, it is changed, update it.
-        query_update.bindValue(QSL(":title"), unnulifyString(message.m_title));
-        query_update.bindValue(QSL(":is_read"), (int) message.m_isRead);
-        query_update.bindValue(QSL(":is_important"), (int) message.m_isImportant);
-        query_update.bindValue(QSL(":url"), unnulifyString(message.m_url));
-        query_update.bindValue(QSL(":author"), unnulifyString(message.m_author));
-        query_update.bindValue(QSL(":date_created"), message.m_created.toMSecsSinceEpoch());
-        query_update.bindValue(QSL(":contents"), unnulifyString(message.m_contents));
-        query_update.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(message.m_enclosures));
-        query_update.bindValue(QSL(":feed"), unnulifyString(feed_id_existing_message));
-        query_update.bindValue(QSL(":id"), id_existing_message);
-        *any_message_changed = true;
-
-        if (query_update.exec()) {
-          qDebug("Updating message with title '%s' url '%s' in DB.", qPrintable(message.m_title), qPrintable(message.m_url));
-
-          if (!message.m_isRead) {
-            updated_messages++;
-          }
-        }
-        else if (query_update.lastError().isValid()) {
-          qWarning("Failed to update message in DB: '%s'.", qPrintable(query_update.lastError().text()));
+        upd_titles << unnulifyString(message.m_title);
+        upd_reads << (int) message.m_isRead;
+        upd_importants << (int) message.m_isImportant;
+        upd_urls << unnulifyString(message.m_url);
+        upd_authors << unnulifyString(message.m_author);
+        upd_dates << message.m_created.toMSecsSinceEpoch();
+        upd_contents << unnulifyString(message.m_contents);
+        upd_enclosures << Enclosures::encodeEnclosuresToString(message.m_enclosures);
+        upd_feeds << unnulifyString(existing_message.m_feedId);
+        upd_ids << existing_message.m_id;
+
+        Message updated_message = existing_message;
+
+        updated_message.m_isRead = message.m_isRead;
+        updated_message.m_isImportant = message.m_isImportant;
+        upd_counts_delta.removeMessage(existing_message);
+        upd_counts_delta.addMessage(updated_message);
+
+        updated_message.m_title = message.m_title;
+        updated_message.m_url = message.m_url;
+        updated_message.m_author = message.m_author;
+        updated_message.m_created = message.m_created;
+        upd_messages.append(updated_message);
+
+        if (!message.m_isRead) {
+          updated_unread_messages++;
         }
-
-        query_update.finish();
       }
     }
     else {
       // Message with this URL is not fetched in this feed yet.
-      query_insert.bindValue(QSL(":feed"), unnulifyString(feed_custom_id));
-      query_insert.bindValue(QSL(":title"), unnulifyString(message.m_title));
-      query_insert.bindValue(QSL(":is_read"), (int) message.m_isRead);
-      query_insert.bindValue(QSL(":is_important"), (int) message.m_isImportant);
-      query_insert.bindValue(QSL(":url"), unnulifyString( message.m_url));
-      query_insert.bindValue(QSL(":author"), unnulifyString(message.m_author));
-      query_insert.bindValue(QSL(":date_created"), message.m_created.toMSecsSinceEpoch());
-      query_insert.bindValue(QSL(":contents"), unnulifyString(message.m_contents));
-      query_insert.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(message.m_enclosures));
-      query_insert.bindValue(QSL(":custom_id"), unnulifyString(message.m_customId));
-      query_insert.bindValue(QSL(":custom_hash"), unnulifyString(message.m_customHash));
-      query_insert.bindValue(QSL(":account_id"), account_id);
-
-      if (query_insert.exec() && query_insert.numRowsAffected() == 1) {
-        updated_messages++;
-
-        qDebug("Adding new message with title '%s' url '%s' to DB.", qPrintable(message.m_title), qPrintable(message.m_url));
-      }
-      else if (query_insert.lastError().isValid()) {
-        qWarning("Failed to insert message to DB: '%s' - message title is '%s'.",
-                 qPrintable(query_insert.lastError().text()),
-                 qPrintable(message.m_title));
-      }
-
-      query_insert.finish();
+      ins_feeds << unnulifyString(feed_custom_id);
+      ins_titles << unnulifyString(message.m_title);
+      ins_reads << (int) message.m_isRead;
+      ins_importants << (int) message.m_isImportant;
+      ins_urls << unnulifyString(message.m_url);
+      ins_authors << unnulifyString(message.m_author);
+      ins_dates << message.m_created.toMSecsSinceEpoch();
+      ins_contents << unnulifyString(message.m_contents);
+      ins_enclosures << Enclosures::encodeEnclosuresToString(message.m_enclosures);
+      ins_custom_ids << unnulifyString(message.m_customId);
+      ins_custom_hashes << unnulifyString(message.m_customHash);
+      ins_account_ids << account_id;
+
+      Message inserted_message = message;
+
+      inserted_message.m_feedId = feed_custom_id;
+      inserted_message.m_isDeleted = inserted_message.m_isPdeleted = false;
+      ins_counts_delta.addMessage(inserted_message);
+      ins_messages.append(inserted_message);
+
+      fixup_custom_ids |= message.m_customId.isEmpty();
+    }
+  }
+
+  if (!upd_ids.isEmpty()) {
+    QSqlQuery query_update(db);
+
+    // Used to update existing messages.
+    query_update.setForwardOnly(true);
+    query_update.prepare("UPDATE Messages "
+                         "SET title = :title, is_read = :is_read, is_important = :is_important, url = :url, author = :author, date_created = :date_created, contents = :contents, enclosures = :enclosures, feed = :feed "
+                         "WHERE id = :id;");
+    query_update.bindValue(QSL(":title"), upd_titles);
+    query_update.bindValue(QSL(":is_read"), upd_reads);
+    query_update.bindValue(QSL(":is_important"), upd_importants);
+    query_update.bindValue(QSL(":url"), upd_urls);
+    query_update.bindValue(QSL(":author"), upd_authors);
+    query_update.bindValue(QSL(":date_created"), upd_dates);
+    query_update.bindValue(QSL(":contents"), upd_contents);
+    query_update.bindValue(QSL(":enclosures"), upd_enclosures);
+    query_update.bindValue(QSL(":feed"), upd_feeds);
+    query_update.bindValue(QSL(":id"), upd_ids);
+    *any_message_changed = true;
+
+    if (query_update.execBatch()) {
+      updated_messages += updated_unread_messages;
+      counts_delta->merge(upd_counts_delta);
+      qApp->feedReader()->duplicateMessageIndex()->addMessages(account_id, upd_messages);
+    }
+    else {
+      qWarning("Failed to update messages in DB: '%s'.", qPrintable(query_update.lastError().text()));
+    }
+  }
+
+  if (!ins_feeds.isEmpty()) {
+    QSqlQuery query_insert(db);
+
+    // Used to insert new messages.
+    query_insert.setForwardOnly(true);
+    query_insert.prepare("INSERT INTO Messages "
+                         "(feed, title, is_read, is_important, url, author, date_created, contents, enclosures, custom_id, custom_hash, account_id) "
+                         "VALUES (:feed, :title, :is_read, :is_important, :url, :author, :date_created, :contents, :enclosures, :custom_id, :custom_hash, :account_id);");
+    query_insert.bindValue(QSL(":feed"), ins_feeds);
+    query_insert.bindValue(QSL(":title"), ins_titles);
+    query_insert.bindValue(QSL(":is_read"), ins_reads);
+    query_insert.bindValue(QSL(":is_important"), ins_importants);
+    query_insert.bindValue(QSL(":url"), ins_urls);
+    query_insert.bindValue(QSL(":author"), ins_authors);
+    query_insert.bindValue(QSL(":date_created"), ins_dates);
+    query_insert.bindValue(QSL(":contents"), ins_contents);
+    query_insert.bindValue(QSL(":enclosures"), ins_enclosures);
+    query_insert.bindValue(QSL(":custom_id"), ins_custom_ids);
+    query_insert.bindValue(QSL(":custom_hash"), ins_custom_hashes);
+    query_insert.bindValue(QSL(":account_id"), ins_account_ids);
+
+    if (query_insert.execBatch()) {
+      updated_messages += ins_feeds.size();
+      counts_delta->merge(ins_counts_delta);
+      qApp->feedReader()->duplicateMessageIndex()->addMessages(account_id, ins_messages);
+    }
+    else {
+      qWarning("Failed to insert messages to DB: '%s'.", qPrintable(query_insert.lastError().text()));
     }
   }
 
+  qDebug("Feed '%s': %d messages inserted, %d messages updated in DB.",
+         qPrintable(feed_custom_id), ins_feeds.size(), upd_ids.size());
+
   // Now, fixup custom IDS for messages which initially did not have them,
   // just to keep the data consistent.
-  if (db.exec("UPDATE Messages "
-              "SET custom_id = id "
-              "WHERE custom_id IS NULL OR custom_id = '';").lastError().isValid()) {
-    qWarning("Failed to set custom ID for all messages: '%s'.", qPrintable(db.lastError().text()));
+  // NOTE: All older messages of this feed already have their custom IDs,
+  // so only just inserted messages are touched here.
+  if (fixup_custom_ids) {
+    QSqlQuery query_fixup(db);
+
+    query_fixup.setForwardOnly(true);
+    query_fixup.prepare(QSL("UPDATE Messages "
+                            "SET custom_id = id "
+                            "WHERE account_id = :account_id AND feed = :feed AND (custom_id IS NULL OR custom_id = '');"));
+    query_fixup.bindValue(QSL(":account_id"), account_id);
+    query_fixup.bindValue(QSL(":feed"), unnulifyString(feed_custom_id));
+
+    if (!query_fixup.exec()) {
+      qWarning("Failed to set custom ID for new messages: '%s'.", qPrintable(query_fixup.lastError().text()));
+    }
   }
 
   if (use_transactions && !db.commit()) {
     qCritical("Transaction commit for message downloader failed: '%s'.", qPrintable(db.lastError().text()));
     db.rollback();
+    *counts_delta = MessageCountsDelta();
 
     if (ok != nullptr) {
       *ok = false;
@@ -745,6 +819,381 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
   return updated_messages;
 }
 
+QList<Message> DatabaseQueries::uniqueMessages(const QList<Message>& messages, bool case_insensitive) {
+  QList<Message> unique_messages;
+  QSet<QString> id_keys;
+  QSet<QString> url_keys;
+
+  unique_messages.reserve(messages.size());
+
+  for (const Message& message : messages) {
+    bool is_new;
+
+    if (message.m_customId.isEmpty()) {
+      const QString url_key = messageUrlKey(message.m_title, message.m_url, message.m_author, case_insensitive);
+
+      is_new = !url_keys.contains(url_key);
+      url_keys.insert(url_key);
+    }
+    else {
+      const QString id_key = messageIdKey(message.m_customId, case_insensitive);
+
+      is_new = !id_keys.contains(id_key);
+      id_keys.insert(id_key);
+    }
+
+    if (is_new) {
+      unique_messages.append(message);
+    }
+  }
+
+  return unique_messages;
+}
+
+QHash<QString, Message> DatabaseQueries::existingMessagesByCustomId(const QSqlDatabase& db, const QStringList& custom_ids,
+                                                                    int account_id, bool case_insensitive, bool* ok) {
+  QHash<QString, Message> messages;
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+
+  for (int i = 0; i < custom_ids.size(); i += APP_DB_IN_CLAUSE_CHUNK_SIZE) {
+    const QStringList chunk = custom_ids.mid(i, APP_DB_IN_CLAUSE_CHUNK_SIZE);
+    QString placeholders = QSL("?, ").repeated(chunk.size());
+
+    placeholders.chop(2);
+    q.prepare(QSL("SELECT id, date_created, is_read, is_important, contents, feed, is_deleted, is_pdeleted, custom_id FROM Messages "
+                  "WHERE account_id = ? AND custom_id IN (%1);").arg(placeholders));
+    q.addBindValue(account_id);
+
+    for (const QString& custom_id : chunk) {
+      q.addBindValue(custom_id);
+    }
+
+    if (!q.exec()) {
+      qWarning("Failed to check for existing messages in DB via ID: '%s'.", qPrintable(q.lastError().text()));
+
+      if (ok != nullptr) {
+        *ok = false;
+      }
+
+      return messages;
+    }
+
+    while (q.next()) {
+      Message message;
+
+      message.m_id = q.value(0).toInt();
+      message.m_created = TextFactory::parseDateTime(q.value(1).value<qint64>());
+      message.m_isRead = q.value(2).toBool();
+      message.m_isImportant = q.value(3).toBool();
+      message.m_contents = q.value(4).toString();
+      message.m_feedId = q.value(5).toString();
+      message.m_isDeleted = q.value(6).toBool();
+      message.m_isPdeleted = q.value(7).toBool();
+      messages.insert(messageIdKey(q.value(8).toString(), case_insensitive), message);
+    }
+  }
+
+  if (ok != nullptr) {
+    *ok = true;
+  }
+
+  return messages;
+}
+
+QHash<QString, Message> DatabaseQueries::existingMessagesByUrl(const QSqlDatabase& db, const QString& feed_custom_id,
+                                                               const QStringList& urls, int account_id,
+                                                               bool case_insensitive, bool* ok) {
+  QHash<QString, Message> messages;
+  QSqlQuery q(db);
+
+#if QT_VERSION >= 0x050E00 // Qt >= 5.14.0
+  const QStringList unique_urls = QSet<QString>(urls.begin(), urls.end()).values();
+#else
+  const QStringList unique_urls = urls.toSet().values();
+#endif
+
+  q.setForwardOnly(true);
+
+  for (int i = 0; i < unique_urls.size(); i += APP_DB_IN_CLAUSE_CHUNK_SIZE) {
+    const QStringList chunk = unique_urls.mid(i, APP_DB_IN_CLAUSE_CHUNK_SIZE);
+    QString placeholders = QSL("?, ").repeated(chunk.size());
+
+    placeholders.chop(2);
+    q.prepare(QSL("SELECT id, date_created, is_read, is_important, contents, feed, is_deleted, is_pdeleted, title, url, author FROM Messages "
+                  "WHERE feed = ? AND account_id = ? AND url IN (%1);").arg(placeholders));
+    q.addBindValue(unnulifyString(feed_custom_id));
+    q.addBindValue(account_id);
+
+    for (const QString& url : chunk) {
+      q.addBindValue(url);
+    }
+
+    if (!q.exec()) {
+      qWarning("Failed to check for existing messages in DB via URL: '%s'.", qPrintable(q.lastError().text()));
+
+      if (ok != nullptr) {
+        *ok = false;
+      }
+
+      return messages;
+    }
+
+    while (q.next()) {
+      Message message;
+
+      message.m_id = q.value(0).toInt();
+      message.m_created = TextFactory::parseDateTime(q.value(1).value<qint64>());
+      message.m_isRead = q.value(2).toBool();
+      message.m_isImportant = q.value(3).toBool();
+      message.m_contents = q.value(4).toString();
+      message.m_feedId = q.value(5).toString();
+      message.m_isDeleted = q.value(6).toBool();
+      message.m_isPdeleted = q.value(7).toBool();
+      messages.insert(messageUrlKey(q.value(8).toString(), q.value(9).toString(), q.value(10).toString(), case_insensitive),
+                      message);
+    }
+  }
+
+  if (ok != nullptr) {
+    *ok = true;
+  }
+
+  return messages;
+}
+
+bool DatabaseQueries::updateMessagesByIds(const QSqlDatabase& db, const QString& statement, const QStringList& ids,
+                                          const QVariantList& values, const std::function<void(int, int)>& progress) {
+  if (ids.isEmpty()) {
+    return true;
+  }
+
+  QSqlDatabase database(db);
+  const bool use_transaction = qApp->settings()->value(GROUP(Database), SETTING(Database::UseTransactions)).toBool();
+  QSqlQuery q(database);
+
+  q.setForwardOnly(true);
+
+  if (use_transaction && !q.exec(qApp->database()->obtainBeginTransactionSql())) {
+    qCritical("Transaction start for bulk update of messages failed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  if (!execUpdateOfMessagesByIds(q, statement, ids, values, progress)) {
+    if (use_transaction) {
+      database.rollback();
+    }
+
+    return false;
+  }
+
+  if (use_transaction && !database.commit()) {
+    qCritical("Transaction commit for bulk update of messages failed: '%s'.", qPrintable(database.lastError().text()));
+    database.rollback();
+    return false;
+  }
+
+  return true;
+}
+
+bool DatabaseQueries::execUpdateOfMessagesByIds(QSqlQuery& q, const QString& statement, const QStringList& ids,
+                                                const QVariantList& values, const std::function<void(int, int)>& progress) {
+  // NOTE: Most chunks have the same size, so the statement
+  // is prepared again only for the last one.
+  int prepared_size = -1;
+
+  for (int i = 0; i < ids.size(); i += APP_DB_IN_CLAUSE_CHUNK_SIZE) {
+    const QStringList chunk = ids.mid(i, APP_DB_IN_CLAUSE_CHUNK_SIZE);
+
+    if (chunk.size() != prepared_size) {
+      QString placeholders = QSL("?, ").repeated(chunk.size());
+
+      placeholders.chop(2);
+      q.prepare(statement.arg(placeholders));
+      prepared_size = chunk.size();
+    }
+
+    for (const QVariant& value : values) {
+      q.addBindValue(value);
+    }
+
+    for (const QString& id : chunk) {
+      q.addBindValue(id.toInt());
+    }
+
+    if (!q.exec()) {
+      qWarning("Bulk update of messages failed: '%s'.", qPrintable(q.lastError().text()));
+      return false;
+    }
+
+    if (progress && ids.size() > APP_DB_IN_CLAUSE_CHUNK_SIZE) {
+      progress(i + chunk.size(), ids.size());
+    }
+  }
+
+  return true;
+}
+
+bool DatabaseQueries::updateMessageStatesOfFeed(const QSqlDatabase& db, const QString& feed_custom_id, int account_id,
+                                                const QSet<QString>& unread_custom_ids,
+                                                const QSet<QString>& important_custom_ids,
+                                                MessageCountsDelta* counts_delta) {
+  QSqlQuery q(db);
+  QList<QPair<Message, Message>> changes;
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT id, custom_id, is_read, is_important, is_deleted, is_pdeleted FROM Messages "
+                "WHERE feed = :feed AND account_id = :account_id;"));
+  q.bindValue(QSL(":feed"), feed_custom_id);
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec()) {
+    qWarning("Failed to obtain states of messages of feed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  while (q.next()) {
+    const QString custom_id = q.value(1).toString();
+    Message message;
+
+    message.m_id = q.value(0).toInt();
+    message.m_feedId = feed_custom_id;
+    message.m_isRead = q.value(2).toBool();
+    message.m_isImportant = q.value(3).toBool();
+    message.m_isDeleted = q.value(4).toBool();
+    message.m_isPdeleted = q.value(5).toBool();
+
+    Message updated_message = message;
+
+    updated_message.m_isRead = !unread_custom_ids.contains(custom_id);
+    updated_message.m_isImportant = important_custom_ids.contains(custom_id);
+    changes.append(QPair<Message, Message>(message, updated_message));
+  }
+
+  return applyMessageStates(db, changes, counts_delta);
+}
+
+bool DatabaseQueries::updateMessageStatesByCustomIds(const QSqlDatabase& db, const QList<Message>& messages, int account_id,
+                                                     MessageCountsDelta* counts_delta, QStringList* missing_custom_ids) {
+  if (messages.isEmpty()) {
+    return true;
+  }
+
+  QStringList custom_ids;
+
+  custom_ids.reserve(messages.size());
+
+  for (const Message& message : messages) {
+    custom_ids.append(message.m_customId);
+  }
+
+  bool ok;
+  const bool case_insensitive = db.driverName() == APP_DB_MYSQL_DRIVER;
+  const QHash<QString, Message> existing_messages = existingMessagesByCustomId(db, custom_ids, account_id, case_insensitive, &ok);
+
+  if (!ok) {
+    return false;
+  }
+
+  QList<QPair<Message, Message>> changes;
+
+  for (const Message& message : messages) {
+    const QString id_key = messageIdKey(message.m_customId, case_insensitive);
+
+    if (!existing_messages.contains(id_key)) {
+      if (missing_custom_ids != nullptr) {
+        missing_custom_ids->append(message.m_customId);
+      }
+
+      continue;
+    }
+
+    const Message existing_message = existing_messages.value(id_key);
+    Message updated_message = existing_message;
+
+    updated_message.m_isRead = message.m_isRead;
+    updated_message.m_isImportant = message.m_isImportant;
+    changes.append(QPair<Message, Message>(existing_message, updated_message));
+  }
+
+  return applyMessageStates(db, changes, counts_delta);
+}
+
+bool DatabaseQueries::applyMessageStates(const QSqlDatabase& db, const QList<QPair<Message, Message>>& changes,
+                                         MessageCountsDelta* counts_delta) {
+  QStringList read_ids, unread_ids, important_ids, unimportant_ids;
+  MessageCountsDelta states_delta;
+
+  for (const QPair<Message, Message>& change : changes) {
+    const Message& message = change.first;
+    const Message& updated_message = change.second;
+
+    if (updated_message.m_isRead != message.m_isRead) {
+      (updated_message.m_isRead ? read_ids : unread_ids).append(QString::number(message.m_id));
+    }
+
+    if (updated_message.m_isImportant != message.m_isImportant) {
+      (updated_message.m_isImportant ? important_ids : unimportant_ids).append(QString::number(message.m_id));
+    }
+
+    if (updated_message.m_isRead != message.m_isRead || updated_message.m_isImportant != message.m_isImportant) {
+      states_delta.removeMessage(message);
+      states_delta.addMessage(updated_message);
+    }
+  }
+
+  if (read_ids.isEmpty() && unread_ids.isEmpty() && important_ids.isEmpty() && unimportant_ids.isEmpty()) {
+    return true;
+  }
+
+  // All states are changed in one transaction, so that counts
+  // of messages are not adjusted for partially stored changes.
+  QSqlDatabase database(db);
+  const bool use_transaction = qApp->settings()->value(GROUP(Database), SETTING(Database::UseTransactions)).toBool();
+  QSqlQuery q(database);
+
+  q.setForwardOnly(true);
+
+  if (use_transaction && !q.exec(qApp->database()->obtainBeginTransactionSql())) {
+    qCritical("Transaction start for update of message states failed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  if (!execUpdateOfMessagesByIds(q, QSL("UPDATE Messages SET is_read = 1 WHERE id IN (%1);"), read_ids) ||
+      !execUpdateOfMessagesByIds(q, QSL("UPDATE Messages SET is_read = 0 WHERE id IN (%1);"), unread_ids) ||
+      !execUpdateOfMessagesByIds(q, QSL("UPDATE Messages SET is_important = 1 WHERE id IN (%1);"), important_ids) ||
+      !execUpdateOfMessagesByIds(q, QSL("UPDATE Messages SET is_important = 0 WHERE id IN (%1);"), unimportant_ids)) {
+    if (use_transaction) {
+      database.rollback();
+    }
+
+    return false;
+  }
+
+  if (use_transaction && !database.commit()) {
+    qCritical("Transaction commit for update of message states failed: '%s'.", qPrintable(database.lastError().text()));
+    database.rollback();
+    return false;
+  }
+
+  if (counts_delta != nullptr) {
+    counts_delta->merge(states_delta);
+  }
+
+  return true;
+}
+
+QString DatabaseQueries::messageUrlKey(const QString& title, const QString& url, const QString& author, bool case_insensitive) {
+  const QString key = unnulifyString(title) + QChar(QChar::Null) + unnulifyString(url) + QChar(QChar::Null) + unnulifyString(author);
+
+  return case_insensitive ? key.toCaseFolded() : key;
+}
+
+QString DatabaseQueries::messageIdKey(const QString& custom_id, bool case_insensitive) {
+  return case_insensitive ? custom_id.toCaseFolded() : custom_id;
+}
+
 bool DatabaseQueries::purgeMessagesFromBin(const QSqlDatabase& db, bool clear_only_read, int account_id) {
   QSqlQuery q(db);
 
@@ -764,6 +1213,8 @@ bool DatabaseQueries::purgeMessagesFromBin(const QSqlDatabase& db, bool clear_on
 bool DatabaseQueries::deleteAccount(const QSqlDatabase& db, int account_id) {
   QSqlQuery query(db);
 
+  qApp->feedReader()->duplicateMessageIndex()->removeAccount(account_id);
+
   query.setForwardOnly(true);
   QStringList queries;
 
@@ -796,6 +1247,7 @@ bool DatabaseQueries::deleteAccountData(const QSqlDatabase& db, int account_id,
   q.setForwardOnly(true);
 
   if (delete_messages_too) {
+    qApp->feedReader()->duplicateMessageIndex()->removeAccount(account_id);
     q.prepare(QSL("DELETE FROM Messages WHERE account_id = :account_id;"));
     q.bindValue(QSL(":account_id"), account_id);
     result &= q.exec();
@@ -1042,6 +1494,46 @@ QStringList DatabaseQueries::customIdsOfMessagesFromFeed(const QSqlDatabase& db,
   return ids;
 }
 
+QStringList DatabaseQueries::customIdsOfExistingMessages(const QSqlDatabase& db, const QStringList& custom_ids,
+                                                         int account_id, bool* ok) {
+  const bool case_insensitive = db.driverName() == APP_DB_MYSQL_DRIVER;
+  const QHash<QString, Message> existing_messages = existingMessagesByCustomId(db, custom_ids, account_id, case_insensitive, ok);
+  QStringList ids;
+
+  for (const QString& custom_id : custom_ids) {
+    const auto existing_message = existing_messages.constFind(messageIdKey(custom_id, case_insensitive));
+
+    if (existing_message != existing_messages.constEnd() && !existing_message->m_isDeleted && !existing_message->m_isPdeleted) {
+      ids.append(custom_id);
+    }
+  }
+
+  return ids;
+}
+
+QHash<QString, qint64> DatabaseQueries::lastCustomIdsOfMessagesInFeeds(const QSqlDatabase& db, int account_id, bool* ok) {
+  QSqlQuery q(db);
+  QHash<QString, qint64> ids;
+
+  // NOTE: Adding zero converts textual custom IDs to numbers in both SQLite and MySQL.
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT feed, MAX(custom_id + 0) FROM Messages WHERE account_id = :account_id GROUP BY feed;"));
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (ok != nullptr) {
+    *ok = q.exec();
+  }
+  else {
+    q.exec();
+  }
+
+  while (q.next()) {
+    ids.insert(q.value(0).toString(), q.value(1).toLongLong());
+  }
+
+  return ids;
+}
+
 QList<ServiceRoot*> DatabaseQueries::getOwnCloudAccounts(const QSqlDatabase& db, bool* ok) {
   QSqlQuery query(db);
   QList<ServiceRoot*> roots;
@@ -1058,6 +1550,7 @@ QList<ServiceRoot*> DatabaseQueries::getOwnCloudAccounts(const QSqlDatabase& db,
       root->network()->setForceServerSideUpdate(query.value(4).toBool());
       root->network()->setBatchSize(query.value(5).toInt());
       root->network()->setDownloadOnlyUnreadMessages(query.value(6).toBool());
+      root->setSyncCursor(query.value(7).toLongLong());
 
       root->updateTitle();
       roots.append(root);
@@ -1132,7 +1625,7 @@ bool DatabaseQueries::overwriteOwnCloudAccount(const QSqlDatabase& db, const QSt
 
   query.prepare("UPDATE OwnCloudAccounts "
                 "SET username = :username, password = :password, url = :url, force_update = :force_update, "
-                "msg_limit = :msg_limit, update_only_unread = :update_only_unread "
+                "msg_limit = :msg_limit, update_only_unread = :update_only_unread, last_modified = 0 "
                 "WHERE id = :id;");
   query.bindValue(QSL(":username"), username);
   query.bindValue(QSL(":password"), TextFactory::encrypt(password));
@@ -1151,6 +1644,22 @@ bool DatabaseQueries::overwriteOwnCloudAccount(const QSqlDatabase& db, const QSt
   }
 }
 
+bool DatabaseQueries::storeOwnCloudLastModified(const QSqlDatabase& db, qint64 last_modified, int account_id) {
+  QSqlQuery query(db);
+
+  query.prepare(QSL("UPDATE OwnCloudAccounts SET last_modified = :last_modified WHERE id = :id;"));
+  query.bindValue(QSL(":last_modified"), last_modified);
+  query.bindValue(QSL(":id"), account_id);
+
+  if (query.exec()) {
+    return true;
+  }
+  else {
+    qWarning("Nextcloud: Storing time of last synchronization failed: '%s'.", qPrintable(query.lastError().text()));
+    return false;
+  }
+}
+
 bool DatabaseQueries::createOwnCloudAccount(const QSqlDatabase& db, int id_to_assign, const QString& username,
                                             const QString& password, const QString& url,
                                             bool force_server_side_feed_update,
@@ -1380,7 +1889,7 @@ bool DatabaseQueries::editStandardFeed(const QSqlDatabase& db, int parent_id, in
 
   q.setForwardOnly(true);
   q.prepare("UPDATE Feeds "
-            "SET title = :title, description = :description, icon = :icon, category = :category, encoding = :encoding, url = :url, protected = :protected, username = :username, password = :password, update_type = :update_type, update_interval = :update_interval, type = :type "
+            "SET title = :title, description = :description, icon = :icon, category = :category, encoding = :encoding, url = :url, protected = :protected, username = :username, password = :password, update_type = :update_type, update_interval = :update_interval, type = :type, http_etag = NULL, http_last_modified = NULL, contents_hash = 0 "
             "WHERE id = :id;");
   q.bindValue(QSL(":title"), title);
   q.bindValue(QSL(":description"), description);
@@ -1412,6 +1921,26 @@ bool DatabaseQueries::editStandardFeed(const QSqlDatabase& db, int parent_id, in
   return suc;
 }
 
+bool DatabaseQueries::storeFeedValidators(const QSqlDatabase& db, int feed_id, const QString& etag,
+                                          const QString& last_modified, quint64 contents_hash) {
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("UPDATE Feeds SET http_etag = :http_etag, http_last_modified = :http_last_modified, contents_hash = :contents_hash "
+                "WHERE id = :id;"));
+  q.bindValue(QSL(":http_etag"), etag.isEmpty() ? QVariant() : etag);
+  q.bindValue(QSL(":http_last_modified"), last_modified.isEmpty() ? QVariant() : last_modified);
+  q.bindValue(QSL(":contents_hash"), qint64(contents_hash));
+  q.bindValue(QSL(":id"), feed_id);
+
+  if (!q.exec()) {
+    qWarning("Failed to store validators of feed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  return true;
+}
+
 bool DatabaseQueries::editBaseFeed(const QSqlDatabase& db, int feed_id, Feed::AutoUpdateType auto_update_type,
                                    int auto_update_interval) {
   QSqlQuery q(db);
@@ -1807,6 +2336,7 @@ QList<ServiceRoot*> DatabaseQueries::getInoreaderAccounts(const QSqlDatabase& db
       root->network()->oauth()->setRefreshToken(query.value(5).toString());
       root->network()->oauth()->setRedirectUrl(query.value(4).toString());
       root->network()->setBatchSize(query.value(6).toInt());
+      root->setSyncCursor(query.value(7).toLongLong());
       root->updateTitle();
       roots.append(root);
     }
@@ -1826,6 +2356,22 @@ QList<ServiceRoot*> DatabaseQueries::getInoreaderAccounts(const QSqlDatabase& db
   return roots;
 }
 
+bool DatabaseQueries::storeInoreaderLastSync(const QSqlDatabase& db, qint64 last_sync, int account_id) {
+  QSqlQuery query(db);
+
+  query.prepare(QSL("UPDATE InoreaderAccounts SET last_sync = :last_sync WHERE id = :id;"));
+  query.bindValue(QSL(":last_sync"), last_sync);
+  query.bindValue(QSL(":id"), account_id);
+
+  if (query.exec()) {
+    return true;
+  }
+  else {
+    qWarning("Inoreader: Storing time of last synchronization failed: '%s'.", qPrintable(query.lastError().text()));
+    return false;
+  }
+}
+
 bool DatabaseQueries::overwriteGmailAccount(const QSqlDatabase& db, const QString& username, const QString& app_id,
                                             const QString& app_key, const QString& redirect_url,
                                             const QString& refresh_token, int batch_size, int account_id) {
@@ -1883,7 +2429,7 @@ bool DatabaseQueries::overwriteInoreaderAccount(const QSqlDatabase& db, const QS
 
   query.prepare("UPDATE InoreaderAccounts "
                 "SET username = :username, app_id = :app_id, app_key = :app_key, "
-                "redirect_url = :redirect_url, refresh_token = :refresh_token , msg_limit = :msg_limit "
+                "redirect_url = :redirect_url, refresh_token = :refresh_token , msg_limit = :msg_limit, last_sync = 0 "
                 "WHERE id = :id;");
   query.bindValue(QSL(":username"), username);
   query.bindValue(QSL(":app_id"), app_id);
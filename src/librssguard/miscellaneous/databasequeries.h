@@ -14,19 +14,27 @@
 #include <QSqlError>
 #include <QSqlQuery>
 
-class DatabaseQueries {
+#include <functional>
+
+class RSSGUARD_DLLSPEC DatabaseQueries {
   public:
 
     // Message operators.
     static bool markImportantMessagesReadUnread(const QSqlDatabase& db, int account_id, RootItem::ReadStatus read);
-    static bool markMessagesReadUnread(const QSqlDatabase& db, const QStringList& ids, RootItem::ReadStatus read);
+    // NOTE: Operators of lists of messages report progress of large updates
+    // via "progress" with count of done and all messages.
+    static bool markMessagesReadUnread(const QSqlDatabase& db, const QStringList& ids, RootItem::ReadStatus read,
+                                       const std::function<void(int, int)>& progress = nullptr);
     static bool markMessageImportant(const QSqlDatabase& db, int id, RootItem::Importance importance);
     static bool markFeedsReadUnread(const QSqlDatabase& db, const QStringList& ids, int account_id, RootItem::ReadStatus read);
     static bool markBinReadUnread(const QSqlDatabase& db, int account_id, RootItem::ReadStatus read);
     static bool markAccountReadUnread(const QSqlDatabase& db, int account_id, RootItem::ReadStatus read);
-    static bool switchMessagesImportance(const QSqlDatabase& db, const QStringList& ids);
-    static bool permanentlyDeleteMessages(const QSqlDatabase& db, const QStringList& ids);
-    static bool deleteOrRestoreMessagesToFromBin(const QSqlDatabase& db, const QStringList& ids, bool deleted);
+    static bool switchMessagesImportance(const QSqlDatabase& db, const QStringList& ids,
+                                         const std::function<void(int, int)>& progress = nullptr);
+    static bool permanentlyDeleteMessages(const QSqlDatabase& db, const QStringList& ids,
+                                          const std::function<void(int, int)>& progress = nullptr);
+    static bool deleteOrRestoreMessagesToFromBin(const QSqlDatabase& db, const QStringList& ids, bool deleted,
+                                                 const std::function<void(int, int)>& progress = nullptr);
     static bool restoreBin(const QSqlDatabase& db, int account_id);
 
     // Purge database.
@@ -50,6 +58,7 @@ class DatabaseQueries {
     static int getMessageCountsForBin(const QSqlDatabase& db, int account_id, bool including_total_counts, bool* ok = nullptr);
 
     // Get messages (for newspaper view for example).
+    static QString getMessageContents(const QSqlDatabase& db, int message_id, bool* ok = nullptr);
     static QList<Message> getUndeletedImportantMessages(const QSqlDatabase& db,
                                                         int account_id,
                                                         bool* ok = nullptr);
@@ -67,10 +76,34 @@ class DatabaseQueries {
     static QStringList customIdsOfMessagesFromFeed(const QSqlDatabase& db, const QString& feed_custom_id, int account_id,
                                                    bool* ok = nullptr);
 
+    // Returns those of given custom IDs, whose messages are stored in DB and are not deleted.
+    static QStringList customIdsOfExistingMessages(const QSqlDatabase& db, const QStringList& custom_ids, int account_id,
+                                                   bool* ok = nullptr);
+
+    // Returns highest numerical custom ID of messages for each feed of the account.
+    static QHash<QString, qint64> lastCustomIdsOfMessagesInFeeds(const QSqlDatabase& db, int account_id, bool* ok = nullptr);
+
     // Common account methods.
     static int createAccount(const QSqlDatabase& db, const QString& code, bool* ok = nullptr);
     static int updateMessages(QSqlDatabase db, const QList<Message>& messages, const QString& feed_custom_id,
-                              int account_id, const QString& url, bool* any_message_changed, bool* ok = nullptr);
+                              int account_id, const QString& url, bool* any_message_changed,
+                              MessageCountsDelta* counts_delta, bool* ok = nullptr);
+
+    // Feed may contain same message more than once, only its first occurrence
+    // is stored. Messages are compared in the same way as when they are
+    // compared with messages already stored in DB.
+    static QList<Message> uniqueMessages(const QList<Message>& messages, bool case_insensitive);
+
+    // Sets read/important states of all messages of the feed, messages with custom ID
+    // in given sets are unread/important and other messages are read/unimportant.
+    static bool updateMessageStatesOfFeed(const QSqlDatabase& db, const QString& feed_custom_id, int account_id,
+                                          const QSet<QString>& unread_custom_ids, const QSet<QString>& important_custom_ids,
+                                          MessageCountsDelta* counts_delta);
+
+    // Sets read/important states of messages with given custom IDs, custom IDs
+    // of messages, which are not stored in DB, are returned in "missing_custom_ids".
+    static bool updateMessageStatesByCustomIds(const QSqlDatabase& db, const QList<Message>& messages, int account_id,
+                                               MessageCountsDelta* counts_delta, QStringList* missing_custom_ids = nullptr);
     static bool deleteAccount(const QSqlDatabase& db, int account_id);
     static bool deleteAccountData(const QSqlDatabase& db, int account_id, bool delete_messages_too);
     static bool cleanImportantMessages(const QSqlDatabase& db, bool clean_read_only, int account_id);
@@ -117,6 +150,8 @@ class DatabaseQueries {
                                  const QString& encoding, const QString& url, bool is_protected,
                                  const QString& username, const QString& password, Feed::AutoUpdateType auto_update_type,
                                  int auto_update_interval, StandardFeed::Type feed_format);
+    static bool storeFeedValidators(const QSqlDatabase& db, int feed_id, const QString& etag, const QString& last_modified,
+                                    quint64 contents_hash);
     static QList<ServiceRoot*> getStandardAccounts(const QSqlDatabase& db, bool* ok = nullptr);
 
     template<typename T>
@@ -128,6 +163,7 @@ class DatabaseQueries {
     static bool overwriteOwnCloudAccount(const QSqlDatabase& db, const QString& username, const QString& password,
                                          const QString& url, bool force_server_side_feed_update, int batch_size,
                                          bool download_only_unread_messages, int account_id);
+    static bool storeOwnCloudLastModified(const QSqlDatabase& db, qint64 last_modified, int account_id);
     static bool createOwnCloudAccount(const QSqlDatabase& db, int id_to_assign, const QString& username, const QString& password,
                                       const QString& url, bool force_server_side_feed_update,
                                       bool download_only_unread_messages, int batch_size);
@@ -158,6 +194,7 @@ class DatabaseQueries {
     static bool deleteInoreaderAccount(const QSqlDatabase& db, int account_id);
     static bool storeNewInoreaderTokens(const QSqlDatabase& db, const QString& refresh_token, int account_id);
     static QList<ServiceRoot*> getInoreaderAccounts(const QSqlDatabase& db, bool* ok = nullptr);
+    static bool storeInoreaderLastSync(const QSqlDatabase& db, qint64 last_sync, int account_id);
     static bool overwriteInoreaderAccount(const QSqlDatabase& db, const QString& username, const QString& app_id,
                                           const QString& app_key, const QString& redirect_url, const QString& refresh_token,
                                           int batch_size, int account_id);
@@ -168,6 +205,36 @@ class DatabaseQueries {
   private:
     static QString unnulifyString(const QString& str);
 
+    // Helpers for batched lookup of already stored messages, returned
+    // messages contain only fields needed to decide if they should be updated.
+    // Returned messages are keyed by "messageIdKey" or "messageUrlKey".
+    static QHash<QString, Message> existingMessagesByCustomId(const QSqlDatabase& db, const QStringList& custom_ids,
+                                                              int account_id, bool case_insensitive, bool* ok = nullptr);
+    static QHash<QString, Message> existingMessagesByUrl(const QSqlDatabase& db, const QString& feed_custom_id,
+                                                         const QStringList& urls, int account_id,
+                                                         bool case_insensitive, bool* ok = nullptr);
+
+    // Keys compare messages in the same way as DB does, MySQL
+    // compares texts case-insensitively, SQLite does not.
+    static QString messageUrlKey(const QString& title, const QString& url, const QString& author, bool case_insensitive);
+    static QString messageIdKey(const QString& custom_id, bool case_insensitive);
+
+    // Runs given statement for messages with given IDs. Statement must contain "%1" in place
+    // of list of IDs, IDs are bound in chunks after "values". All chunks are run in one transaction,
+    // progress is reported after each chunk if there is more than one.
+    static bool updateMessagesByIds(const QSqlDatabase& db, const QString& statement, const QStringList& ids,
+                                    const QVariantList& values = QVariantList(),
+                                    const std::function<void(int, int)>& progress = nullptr);
+
+    // Runs chunks of the update on given query, caller handles the transaction.
+    static bool execUpdateOfMessagesByIds(QSqlQuery& q, const QString& statement, const QStringList& ids,
+                                          const QVariantList& values = QVariantList(),
+                                          const std::function<void(int, int)>& progress = nullptr);
+
+    // Stores changed read/important states, each change is pair of message with its old and new state.
+    static bool applyMessageStates(const QSqlDatabase& db, const QList<QPair<Message, Message>>& changes,
+                                   MessageCountsDelta* counts_delta);
+
     explicit DatabaseQueries();
 };
 
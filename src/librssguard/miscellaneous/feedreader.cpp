@@ -212,6 +212,10 @@ FeedDownloader* FeedReader::feedDownloader() const {
   return m_feedDownloader;
 }
 
+DuplicateMessageIndex* FeedReader::duplicateMessageIndex() {
+  return &m_duplicateMessageIndex;
+}
+
 FeedsModel* FeedReader::feedsModel() const {
   return m_feedsModel;
 }
@@ -5,6 +5,7 @@
 
 #include <QObject>
 
+#include "core/duplicatemessageindex.h"
 #include "core/feeddownloader.h"
 #include "core/messagefilter.h"
 #include "services/abstract/feed.h"
@@ -35,6 +36,7 @@ class RSSGUARD_DLLSPEC FeedReader : public QObject {
     MessagesModel* messagesModel() const;
     FeedsProxyModel* feedsProxyModel() const;
     MessagesProxyModel* messagesProxyModel() const;
+    DuplicateMessageIndex* duplicateMessageIndex();
 
     // Schedules given feeds for update.
     void updateFeeds(const QList<Feed*>& feeds);
@@ -78,6 +80,7 @@ class RSSGUARD_DLLSPEC FeedReader : public QObject {
   private:
     QList<ServiceEntryPoint*> m_feedServices;
     QList<MessageFilter*> m_messageFilters;
+    DuplicateMessageIndex m_duplicateMessageIndex;
     FeedsModel* m_feedsModel;
     FeedsProxyModel* m_feedsProxyModel;
     MessagesModel* m_messagesModel;
@@ -31,6 +31,14 @@ DKEY Feeds::UpdateTimeout = "feed_update_timeout";
 
 DVALUE(int) Feeds::UpdateTimeoutDef = DOWNLOAD_TIMEOUT;
 
+DKEY Feeds::UpdateConcurrency = "feed_update_concurrency";
+
+DVALUE(int) Feeds::UpdateConcurrencyDef = FEED_DOWNLOADER_MAX_THREADS;
+
+DKEY Feeds::UpdateConcurrencyPerHost = "feed_update_concurrency_per_host";
+
+DVALUE(int) Feeds::UpdateConcurrencyPerHostDef = FEED_DOWNLOADER_MAX_HOST_THREADS;
+
 DKEY Feeds::EnableAutoUpdateNotification = "enable_auto_update_notification";
 
 DVALUE(bool) Feeds::EnableAutoUpdateNotificationDef = true;
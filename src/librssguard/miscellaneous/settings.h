@@ -52,6 +52,14 @@ namespace Feeds {
 
   VALUE(int) UpdateTimeoutDef;
 
+  KEY UpdateConcurrency;
+
+  VALUE(int) UpdateConcurrencyDef;
+
+  KEY UpdateConcurrencyPerHost;
+
+  VALUE(int) UpdateConcurrencyPerHostDef;
+
   KEY EnableAutoUpdateNotification;
 
   VALUE(bool) EnableAutoUpdateNotificationDef;
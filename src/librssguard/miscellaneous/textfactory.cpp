@@ -43,23 +43,240 @@ int TextFactory::stringWidth(const QString& string, const QFontMetrics& metrics)
   return width;
 }
 
+static void skipSpaces(const QString& text, int& pos) {
+  while (pos < text.size() && text.at(pos).isSpace()) {
+    pos++;
+  }
+}
+
+static bool skipChar(const QString& text, int& pos, QChar chr) {
+  if (pos < text.size() && text.at(pos) == chr) {
+    pos++;
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
+// Reads unsigned number with given count of digits, returns -1 if there is no such number.
+static int readNumber(const QString& text, int& pos, int min_digits, int max_digits) {
+  int number = 0;
+  int digits = 0;
+
+  while (pos < text.size() && digits < max_digits && text.at(pos).isDigit()) {
+    number = number * 10 + text.at(pos++).digitValue();
+    digits++;
+  }
+
+  return digits < min_digits ? -1 : number;
+}
+
+// Reads english three-letter month name, returns -1 if there is no such name.
+static int readMonth(const QString& text, int& pos) {
+  static const char* months[] = { "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec" };
+
+  if (pos + 3 > text.size() || (pos + 3 < text.size() && text.at(pos + 3).isLetter())) {
+    return -1;
+  }
+
+  const QStringRef name = text.midRef(pos, 3);
+
+  for (int i = 0; i < 12; i++) {
+    if (name.compare(QLatin1String(months[i]), Qt::CaseSensitivity::CaseInsensitive) == 0) {
+      pos += 3;
+      return i + 1;
+    }
+  }
+
+  return -1;
+}
+
+// Reads optional time zone, which must be the last part of the text.
+// Only numerical offsets and zones equal to UTC are supported.
+static bool readTimeZoneOffset(const QString& text, int& pos, int& offset_secs) {
+  offset_secs = 0;
+  skipSpaces(text, pos);
+
+  if (pos >= text.size()) {
+    return true;
+  }
+
+  const QChar sign = text.at(pos);
+
+  if (sign == QL1C('+') || sign == QL1C('-')) {
+    pos++;
+
+    const int hours = readNumber(text, pos, 2, 2);
+
+    skipChar(text, pos, QL1C(':'));
+
+    const int minutes = pos < text.size() && text.at(pos).isDigit() ? readNumber(text, pos, 2, 2) : 0;
+
+    if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+      return false;
+    }
+
+    offset_secs = (hours * 3600 + minutes * 60) * (sign == QL1C('-') ? -1 : 1);
+  }
+  else {
+    const int zone_start = pos;
+
+    while (pos < text.size() && text.at(pos).isLetter()) {
+      pos++;
+    }
+
+    const QStringRef zone = text.midRef(zone_start, pos - zone_start);
+
+    if (zone != QL1S("Z") && zone != QL1S("UT") && zone != QL1S("UTC") && zone != QL1S("GMT")) {
+      return false;
+    }
+  }
+
+  skipSpaces(text, pos);
+  return pos >= text.size();
+}
+
+// Parses "[ddd,] d MMM yyyy HH:mm[:ss] [zone]" or "d MMM yyyy".
+QDateTime TextFactory::parseRfc822DateTime(const QString& date_time) {
+  int pos = 0;
+
+  skipSpaces(date_time, pos);
+
+  if (pos < date_time.size() && date_time.at(pos).isLetter()) {
+    // Day of week is ignored.
+    while (pos < date_time.size() && date_time.at(pos).isLetter()) {
+      pos++;
+    }
+
+    if (!skipChar(date_time, pos, QL1C(','))) {
+      return QDateTime();
+    }
+
+    skipSpaces(date_time, pos);
+  }
+
+  const int day = readNumber(date_time, pos, 1, 2);
+
+  skipSpaces(date_time, pos);
+
+  const int month = readMonth(date_time, pos);
+
+  skipSpaces(date_time, pos);
+
+  const int year = readNumber(date_time, pos, 4, 4);
+  const QDate date(year, month, day);
+
+  if (day < 0 || month < 0 || year < 0 || !date.isValid()) {
+    return QDateTime();
+  }
+
+  skipSpaces(date_time, pos);
+
+  if (pos >= date_time.size()) {
+    return QDateTime(date, QTime(0, 0), Qt::UTC);
+  }
+
+  const int hours = readNumber(date_time, pos, 1, 2);
+  const int minutes = skipChar(date_time, pos, QL1C(':')) ? readNumber(date_time, pos, 2, 2) : -1;
+  const int seconds = skipChar(date_time, pos, QL1C(':')) ? readNumber(date_time, pos, 2, 2) : 0;
+  const QTime time(hours, minutes, seconds);
+  int offset_secs;
+
+  if (hours < 0 || minutes < 0 || seconds < 0 || !time.isValid() ||
+      !readTimeZoneOffset(date_time, pos, offset_secs)) {
+    return QDateTime();
+  }
+
+  return QDateTime(date, time, Qt::UTC).addSecs(-offset_secs);
+}
+
+// Parses "yyyy-MM-dd[(T| )HH:mm[:ss[.zzz]]][zone]".
+QDateTime TextFactory::parseIso8601DateTime(const QString& date_time) {
+  int pos = 0;
+
+  skipSpaces(date_time, pos);
+
+  const int year = readNumber(date_time, pos, 4, 4);
+  const int month = skipChar(date_time, pos, QL1C('-')) ? readNumber(date_time, pos, 2, 2) : -1;
+  const int day = skipChar(date_time, pos, QL1C('-')) ? readNumber(date_time, pos, 2, 2) : -1;
+  const QDate date(year, month, day);
+
+  if (year < 0 || month < 0 || day < 0 || !date.isValid()) {
+    return QDateTime();
+  }
+
+  int offset_secs;
+
+  if (!skipChar(date_time, pos, QL1C('T')) && !skipChar(date_time, pos, QL1C(' '))) {
+    return readTimeZoneOffset(date_time, pos, offset_secs) && offset_secs == 0
+           ? QDateTime(date, QTime(0, 0), Qt::UTC)
+           : QDateTime();
+  }
+
+  const int hours = readNumber(date_time, pos, 2, 2);
+  const int minutes = skipChar(date_time, pos, QL1C(':')) ? readNumber(date_time, pos, 2, 2) : -1;
+  const int seconds = skipChar(date_time, pos, QL1C(':')) ? readNumber(date_time, pos, 2, 2) : 0;
+  int msecs = 0;
+
+  if (seconds >= 0 && (skipChar(date_time, pos, QL1C('.')) || skipChar(date_time, pos, QL1C(',')))) {
+    // Only milliseconds are used from fractional part of seconds.
+    int digits = 0;
+
+    for (; pos < date_time.size() && date_time.at(pos).isDigit(); pos++, digits++) {
+      if (digits < 3) {
+        msecs = msecs * 10 + date_time.at(pos).digitValue();
+      }
+    }
+
+    if (digits == 0) {
+      return QDateTime();
+    }
+
+    for (; digits < 3; digits++) {
+      msecs *= 10;
+    }
+  }
+
+  const QTime time(hours, minutes, seconds, msecs);
+
+  if (hours < 0 || minutes < 0 || seconds < 0 || !time.isValid() ||
+      !readTimeZoneOffset(date_time, pos, offset_secs)) {
+    return QDateTime();
+  }
+
+  return QDateTime(date, time, Qt::UTC).addSecs(-offset_secs);
+}
+
 QDateTime TextFactory::parseDateTime(const QString& date_time) {
+  // Most of feeds use RFC 822 or ISO 8601 date/times, which are parsed directly,
+  // other formats are tried one by one.
+  QDateTime dt = parseIso8601DateTime(date_time);
+
+  if (dt.isValid()) {
+    return dt;
+  }
+
+  dt = parseRfc822DateTime(date_time);
+
+  if (dt.isValid()) {
+    return dt;
+  }
+
   const QString input_date = date_time.simplified();
-  QDateTime dt;
   QTime time_zone_offset;
   const QLocale locale(QLocale::C);
   bool positive_time_zone_offset = false;
-  QStringList date_patterns;
-
-  date_patterns << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
-    QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") << QSL("ddd, d MMM yyyy HH:mm:ss") <<
-    QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
-    QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
-    QSL("yyyy-MM-ddThh:mm:ss");
-  QStringList timezone_offset_patterns;
-
-  timezone_offset_patterns << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
-                           << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
+  static const QStringList date_patterns = {
+    QSL("yyyy-MM-ddTHH:mm:ss"), QSL("MMM dd yyyy hh:mm:ss"),
+    QSL("MMM d yyyy hh:mm:ss"), QSL("ddd, dd MMM yyyy HH:mm:ss"), QSL("ddd, d MMM yyyy HH:mm:ss"),
+    QSL("dd MMM yyyy"), QSL("yyyy-MM-dd HH:mm:ss.z"), QSL("yyyy-MM-dd"),
+    QSL("yyyy"), QSL("yyyy-MM"), QSL("yyyy-MM-dd"), QSL("yyyy-MM-ddThh:mm"),
+    QSL("yyyy-MM-ddThh:mm:ss")
+  };
+  static const QStringList timezone_offset_patterns = {
+    QSL("+hh:mm"), QSL("-hh:mm"), QSL("+hhmm"), QSL("-hhmm"), QSL("+hh"), QSL("-hh")
+  };
 
   // Iterate over patterns and check if input date/time matches the pattern.
   for (const QString& pattern : date_patterns) {
@@ -34,6 +34,9 @@ class TextFactory {
     static QString shorten(const QString& input, int text_length_limit = TEXT_TITLE_LIMIT);
 
   private:
+    static QDateTime parseRfc822DateTime(const QString& date_time);
+    static QDateTime parseIso8601DateTime(const QString& date_time);
+
     static quint64 initializeSecretEncryptionKey();
     static quint64 generateSecretEncryptionKey();
     static quint64 s_encryptionKey;
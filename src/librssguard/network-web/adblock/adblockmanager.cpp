@@ -199,6 +199,7 @@ bool AdBlockManager::removeSubscription(AdBlockSubscription* subscription) {
   }
 
   QFile(subscription->filePath()).remove();
+  QFile(subscription->filePath() + QSL(ADBLOCK_CACHE_SUFFIX)).remove();
   m_subscriptions.removeOne(subscription);
   m_matcher->update();
   delete subscription;
@@ -38,14 +38,8 @@ const AdBlockRule* AdBlockMatcher::match(const QWebEngineUrlRequestInfo& request
     return nullptr;
   }
 
-  int count = m_networkExceptionRules.count();
-
-  for (int i = 0; i < count; ++i) {
-    const AdBlockRule* rule = m_networkExceptionRules.at(i);
-
-    if (rule->networkMatch(request, urlDomain, urlString)) {
-      return nullptr;
-    }
+  if (m_networkExceptionIndex.find(request, urlDomain, urlString) != nullptr) {
+    return nullptr;
   }
 
   // Block rules.
@@ -53,17 +47,7 @@ const AdBlockRule* AdBlockMatcher::match(const QWebEngineUrlRequestInfo& request
     return rule;
   }
 
-  count = m_networkBlockRules.count();
-
-  for (int i = 0; i < count; ++i) {
-    const AdBlockRule* rule = m_networkBlockRules.at(i);
-
-    if (rule->networkMatch(request, urlDomain, urlString)) {
-      return rule;
-    }
-  }
-
-  return nullptr;
+  return m_networkBlockIndex.find(request, urlDomain, urlString);
 }
 
 bool AdBlockMatcher::adBlockDisabledForUrl(const QUrl& url) const {
@@ -163,12 +147,12 @@ void AdBlockMatcher::update() {
       }
       else if (rule->isException()) {
         if (!m_networkExceptionTree.add(rule)) {
-          m_networkExceptionRules.append(rule);
+          m_networkExceptionIndex.add(rule);
         }
       }
       else {
         if (!m_networkBlockTree.add(rule)) {
-          m_networkBlockRules.append(rule);
+          m_networkBlockIndex.add(rule);
         }
       }
     }
@@ -223,9 +207,9 @@ void AdBlockMatcher::update() {
 
 void AdBlockMatcher::clear() {
   m_networkExceptionTree.clear();
-  m_networkExceptionRules.clear();
+  m_networkExceptionIndex.clear();
   m_networkBlockTree.clear();
-  m_networkBlockRules.clear();
+  m_networkBlockIndex.clear();
   m_domainRestrictedCssRules.clear();
   m_elementHidingRules.clear();
   m_documentRules.clear();
@@ -22,6 +22,7 @@
 
 #include <QUrl>
 
+#include "network-web/adblock/adblockruleindex.h"
 #include "network-web/adblock/adblocksearchtree.h"
 
 #include <QObject>
@@ -53,8 +54,6 @@ class AdBlockMatcher : public QObject {
     AdBlockManager* m_manager;
 
     QVector<AdBlockRule*> m_createdRules;
-    QVector<const AdBlockRule*> m_networkExceptionRules;
-    QVector<const AdBlockRule*> m_networkBlockRules;
     QVector<const AdBlockRule*> m_domainRestrictedCssRules;
     QVector<const AdBlockRule*> m_documentRules;
     QVector<const AdBlockRule*> m_elemhideRules;
@@ -62,6 +61,8 @@ class AdBlockMatcher : public QObject {
     QString m_elementHidingRules;
     AdBlockSearchTree m_networkBlockTree;
     AdBlockSearchTree m_networkExceptionTree;
+    AdBlockRuleIndex m_networkBlockIndex;
+    AdBlockRuleIndex m_networkExceptionIndex;
 };
 
 #endif // ADBLOCKMATCHER_H
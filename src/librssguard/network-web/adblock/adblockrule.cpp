@@ -51,6 +51,7 @@
 #include "definitions/definitions.h"
 #include "network-web/adblock/adblocksubscription.h"
 
+#include <QDataStream>
 #include <QRegularExpression>
 #include <QString>
 #include <QStringList>
@@ -100,11 +101,48 @@ AdBlockRule* AdBlockRule::copy() const {
   rule->m_isInternalDisabled = m_isInternalDisabled;
   rule->m_allowedDomains = m_allowedDomains;
   rule->m_blockedDomains = m_blockedDomains;
+  rule->m_regexPattern = m_regexPattern;
+  rule->m_regExp = m_regExp;
+  rule->m_matchToken = m_matchToken;
   rule->matchers = matchers;
 
   return rule;
 }
 
+void AdBlockRule::saveToStream(QDataStream& stream) const {
+  QStringList matcher_patterns;
+
+  for (const QStringMatcher& matcher : matchers) {
+    matcher_patterns.append(matcher.pattern());
+  }
+
+  stream << int(m_type) << int(m_options) << int(m_exceptions) << m_filter << m_matchString
+         << int(m_caseSensitivity) << m_isEnabled << m_isException << m_isInternalDisabled
+         << m_allowedDomains << m_blockedDomains << m_regexPattern << m_matchToken << matcher_patterns;
+}
+
+AdBlockRule* AdBlockRule::loadFromStream(QDataStream& stream, AdBlockSubscription* subscription) {
+  int type, options, exceptions, case_sensitivity;
+  QStringList matcher_patterns;
+  auto* rule = new AdBlockRule(QString(), subscription);
+
+  stream >> type >> options >> exceptions >> rule->m_filter >> rule->m_matchString
+  >> case_sensitivity >> rule->m_isEnabled >> rule->m_isException >> rule->m_isInternalDisabled
+  >> rule->m_allowedDomains >> rule->m_blockedDomains >> rule->m_regexPattern >> rule->m_matchToken >> matcher_patterns;
+
+  rule->m_type = RuleType(type);
+  rule->m_options = RuleOptions(QFlag(options));
+  rule->m_exceptions = RuleOptions(QFlag(exceptions));
+  rule->m_caseSensitivity = Qt::CaseSensitivity(case_sensitivity);
+  rule->matchers = rule->createStringMatchers(matcher_patterns);
+
+  if (rule->m_type == RegExpMatchRule) {
+    rule->compileRegExp();
+  }
+
+  return rule;
+}
+
 AdBlockSubscription* AdBlockRule::subscription() const {
   return m_subscription;
 }
@@ -458,6 +496,7 @@ void AdBlockRule::parseFilter() {
     m_type = RegExpMatchRule;
     m_regexPattern = parsedLine;
     matchers = createStringMatchers(parseRegExpFilter(parsedLine));
+    compileRegExp();
     return;
   }
 
@@ -484,6 +523,7 @@ void AdBlockRule::parseFilter() {
     parsedLine = parsedLine.left(parsedLine.size() - 1);
     m_type = StringEndsMatchRule;
     m_matchString = parsedLine;
+    m_matchToken = findMatchToken(parsedLine, true);
     return;
   }
 
@@ -492,7 +532,9 @@ void AdBlockRule::parseFilter() {
   if (parsedLine.contains(QL1C('*')) || parsedLine.contains(QL1C('^')) || parsedLine.contains(QL1C('|'))) {
     m_type = RegExpMatchRule;
     m_regexPattern = createRegExpFromFilter(parsedLine);
+    m_matchToken = findMatchToken(parsedLine, false);
     matchers = createStringMatchers(parseRegExpFilter(parsedLine));
+    compileRegExp();
     return;
   }
 
@@ -639,14 +681,53 @@ QList<QStringMatcher> AdBlockRule::createStringMatchers(const QStringList& filte
   return mtchrs;
 }
 
-int AdBlockRule::regexMatched(const QString& str, int offset) const {
-  QRegularExpression exp(m_regexPattern);
+static bool isTokenCharacter(const QChar& c) {
+  return c.unicode() < 128 && c.isLetterOrNumber();
+}
+
+QString AdBlockRule::findMatchToken(const QString& filter, bool anchored_at_end) const {
+  // Word can be used as token only if it is surely not part of longer word in matched URL,
+  // so it must not be adjacent to wildcard (*) or to unanchored start/end of filter.
+  QString best_token;
+
+  for (int i = 0; i < filter.size(); ) {
+    if (!isTokenCharacter(filter.at(i))) {
+      i++;
+      continue;
+    }
+
+    int end = i;
+
+    while (end < filter.size() && isTokenCharacter(filter.at(end))) {
+      end++;
+    }
+
+    const bool bounded_left = i > 0 && filter.at(i - 1) != QL1C('*');
+    const bool bounded_right = end == filter.size() ? anchored_at_end : filter.at(end) != QL1C('*');
+
+    if (bounded_left && bounded_right && end - i > best_token.size()) {
+      best_token = filter.mid(i, end - i);
+    }
+
+    i = end;
+  }
+
+  return best_token.toLower();
+}
+
+void AdBlockRule::compileRegExp() {
+  m_regExp.setPattern(m_regexPattern);
 
   if (m_caseSensitivity == Qt::CaseSensitivity::CaseInsensitive) {
-    exp.setPatternOptions(exp.patternOptions() | QRegularExpression::PatternOption::CaseInsensitiveOption);
+    m_regExp.setPatternOptions(m_regExp.patternOptions() | QRegularExpression::PatternOption::CaseInsensitiveOption);
   }
 
-  QRegularExpressionMatch m = exp.match(str, offset);
+  // NOTE: Pattern itself is compiled when it is first used
+  // for matching, so that loading of rules stays fast.
+}
+
+int AdBlockRule::regexMatched(const QString& str, int offset) const {
+  QRegularExpressionMatch m = m_regExp.match(str, offset);
 
   if (!m.hasMatch()) {
     return -1;
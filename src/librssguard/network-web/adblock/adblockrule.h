@@ -49,9 +49,11 @@
 #define ADBLOCKRULE_H
 
 #include <QObject>
+#include <QRegularExpression>
 #include <QStringList>
 #include <QStringMatcher>
 
+class QDataStream;
 class QUrl;
 class QWebEngineUrlRequestInfo;
 class AdBlockSubscription;
@@ -66,6 +68,11 @@ class AdBlockRule {
     AdBlockRule* copy() const;
     AdBlockSubscription* subscription() const;
 
+    // Stores already parsed rule, so that it can be
+    // loaded later without parsing its filter again.
+    void saveToStream(QDataStream& stream) const;
+    static AdBlockRule* loadFromStream(QDataStream& stream, AdBlockSubscription* subscription);
+
     void setSubscription(AdBlockSubscription* subscription);
 
     QString filter() const;
@@ -145,6 +152,8 @@ class AdBlockRule {
     bool filterIsOnlyEndsMatch(const QString& filter) const;
     int regexMatched(const QString& str, int offset = 0) const;
     QString createRegExpFromFilter(const QString& filter) const;
+    QString findMatchToken(const QString& filter, bool anchored_at_end) const;
+    void compileRegExp();
     QList<QStringMatcher> createStringMatchers(const QStringList& filters) const;
 
     AdBlockSubscription* m_subscription;
@@ -167,10 +176,16 @@ class AdBlockRule {
     QStringList m_allowedDomains;
     QStringList m_blockedDomains;
     QString m_regexPattern;
+    QRegularExpression m_regExp;
+
+    // Lowercased alphanumeric word which must be present as whole
+    // word in every URL matched by this rule, used by AdBlockRuleIndex.
+    QString m_matchToken;
 
     QList<QStringMatcher> matchers;
 
     friend class AdBlockMatcher;
+    friend class AdBlockRuleIndex;
     friend class AdBlockSearchTree;
     friend class AdBlockSubscription;
 };
@@ -0,0 +1,123 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "network-web/adblock/adblockruleindex.h"
+
+#include "definitions/definitions.h"
+#include "network-web/adblock/adblockrule.h"
+
+#include <QSet>
+#include <QWebEngineUrlRequestInfo>
+
+void AdBlockRuleIndex::clear() {
+  m_domainRules.clear();
+  m_tokenRules.clear();
+  m_firstPartyDomainRules.clear();
+  m_otherRules.clear();
+}
+
+void AdBlockRuleIndex::add(const AdBlockRule* rule) {
+  if (rule->m_type == AdBlockRule::DomainMatchRule) {
+    m_domainRules[rule->m_matchString].append(rule);
+  }
+  else if (!rule->m_matchToken.isEmpty()) {
+    m_tokenRules[rule->m_matchToken].append(rule);
+  }
+  else if (rule->isDomainRestricted() && rule->m_blockedDomains.isEmpty() && !rule->m_allowedDomains.isEmpty()) {
+    for (const QString& allowed_domain : rule->m_allowedDomains) {
+      m_firstPartyDomainRules[allowed_domain].append(rule);
+    }
+  }
+  else {
+    m_otherRules.append(rule);
+  }
+}
+
+const AdBlockRule* AdBlockRuleIndex::find(const QWebEngineUrlRequestInfo& request, const QString& domain,
+                                          const QString& urlString) const {
+  if (const AdBlockRule* rule = findInDomainHash(m_domainRules, domain, request, domain, urlString)) {
+    return rule;
+  }
+
+  if (!m_tokenRules.isEmpty()) {
+    QSet<QString> checked_tokens;
+    const int len = urlString.size();
+
+    for (int i = 0; i < len; ) {
+      const QChar c = urlString.at(i);
+
+      if (c.unicode() >= 128 || !c.isLetterOrNumber()) {
+        i++;
+        continue;
+      }
+
+      int end = i + 1;
+
+      while (end < len && urlString.at(end).unicode() < 128 && urlString.at(end).isLetterOrNumber()) {
+        end++;
+      }
+
+      const QString token = urlString.mid(i, end - i).toLower();
+
+      i = end;
+
+      if (checked_tokens.contains(token)) {
+        continue;
+      }
+
+      checked_tokens.insert(token);
+
+      auto rules = m_tokenRules.constFind(token);
+
+      if (rules != m_tokenRules.constEnd()) {
+        if (const AdBlockRule* rule = findInRules(rules.value(), request, domain, urlString)) {
+          return rule;
+        }
+      }
+    }
+  }
+
+  if (!m_firstPartyDomainRules.isEmpty()) {
+    if (const AdBlockRule* rule = findInDomainHash(m_firstPartyDomainRules, request.firstPartyUrl().host(),
+                                                   request, domain, urlString)) {
+      return rule;
+    }
+  }
+
+  return findInRules(m_otherRules, request, domain, urlString);
+}
+
+const AdBlockRule* AdBlockRuleIndex::findInDomainHash(const QHash<QString, QVector<const AdBlockRule*>>& hash,
+                                                      const QString& domain, const QWebEngineUrlRequestInfo& request,
+                                                      const QString& urlDomain, const QString& urlString) const {
+  if (hash.isEmpty() || domain.isEmpty()) {
+    return nullptr;
+  }
+
+  // Domain itself and all its parent domains are looked up.
+  for (int start = 0; start >= 0; ) {
+    auto rules = hash.constFind(domain.mid(start));
+
+    if (rules != hash.constEnd()) {
+      if (const AdBlockRule* rule = findInRules(rules.value(), request, urlDomain, urlString)) {
+        return rule;
+      }
+    }
+
+    start = domain.indexOf(QL1C('.'), start);
+    start = start < 0 ? -1 : start + 1;
+  }
+
+  return nullptr;
+}
+
+const AdBlockRule* AdBlockRuleIndex::findInRules(const QVector<const AdBlockRule*>& rules,
+                                                 const QWebEngineUrlRequestInfo& request,
+                                                 const QString& domain, const QString& urlString) const {
+  for (const AdBlockRule* rule : rules) {
+    if (rule->networkMatch(request, domain, urlString)) {
+      return rule;
+    }
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,42 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef ADBLOCKRULEINDEX_H
+#define ADBLOCKRULEINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class QWebEngineUrlRequestInfo;
+class AdBlockRule;
+
+// Dispatches network rules which cannot be stored in AdBlockSearchTree, so
+// that only small subset of them is checked for each URL:
+//   1) domain rules (||example.com^) are keyed by their domain,
+//   2) rules with match token are keyed by that token, URL is split to words
+//      and only rules keyed by those words are checked,
+//   3) remaining rules restricted to some domains via $domain= are keyed by those domains
+//      and checked only for requests originating from them.
+class AdBlockRuleIndex {
+  public:
+    explicit AdBlockRuleIndex() = default;
+
+    void clear();
+    void add(const AdBlockRule* rule);
+
+    const AdBlockRule* find(const QWebEngineUrlRequestInfo& request, const QString& domain, const QString& urlString) const;
+
+  private:
+    const AdBlockRule* findInDomainHash(const QHash<QString, QVector<const AdBlockRule*>>& hash, const QString& domain,
+                                        const QWebEngineUrlRequestInfo& request, const QString& urlDomain,
+                                        const QString& urlString) const;
+    const AdBlockRule* findInRules(const QVector<const AdBlockRule*>& rules, const QWebEngineUrlRequestInfo& request,
+                                   const QString& domain, const QString& urlString) const;
+
+    QHash<QString, QVector<const AdBlockRule*>> m_domainRules;
+    QHash<QString, QVector<const AdBlockRule*>> m_tokenRules;
+    QHash<QString, QVector<const AdBlockRule*>> m_firstPartyDomainRules;
+    QVector<const AdBlockRule*> m_otherRules;
+};
+
+#endif // ADBLOCKRULEINDEX_H
@@ -73,7 +73,7 @@ const AdBlockRule* AdBlockSearchTree::find(const QWebEngineUrlRequestInfo& reque
   }
 
   for (int i = 0; i < len; ++i) {
-    const AdBlockRule* rule = prefixSearch(request, domain, urlString, urlString.mid(i), len - i);
+    const AdBlockRule* rule = prefixSearch(request, domain, urlString, i);
 
     if (rule != nullptr) {
       return rule;
@@ -84,19 +84,23 @@ const AdBlockRule* AdBlockSearchTree::find(const QWebEngineUrlRequestInfo& reque
 }
 
 const AdBlockRule* AdBlockSearchTree::prefixSearch(const QWebEngineUrlRequestInfo& request, const QString& domain,
-                                                   const QString& urlString, const QString& choppedUrlString, int len) const {
-  if (len <= 0) {
+                                                   const QString& urlString, int start) const {
+  // NOTE: URL is searched from given position, it is not copied
+  // to avoid allocation for each position.
+  const int len = urlString.size();
+
+  if (start >= len) {
     return nullptr;
   }
 
-  Node* node = m_root->children.value(choppedUrlString.at(0));
+  Node* node = m_root->children.value(urlString.at(start));
 
   if (node == nullptr) {
     return nullptr;
   }
 
-  for (int i = 1; i < len; ++i) {
-    const QChar c = choppedUrlString.at(i);
+  for (int i = start + 1; i < len; ++i) {
+    const QChar c = urlString.at(i);
 
     if ((node->rule != nullptr) && node->rule->networkMatch(request, domain, urlString)) {
       return node->rule;
@@ -55,13 +55,40 @@
 #include "network-web/adblock/adblocksearchtree.h"
 #include "network-web/silentnetworkaccessmanager.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDir>
 #include <QFile>
 #include <QNetworkReply>
 #include <QSaveFile>
+#include <QRunnable>
+#include <QSet>
+#include <QThreadPool>
 #include <QTimer>
 #include <utility>
 
+// Writes serialized AdBlock rules to cache file. Runs in thread pool.
+class AdBlockCacheWriteTask : public QRunnable {
+  public:
+    explicit AdBlockCacheWriteTask(const QString& file_path, const QByteArray& data)
+      : m_filePath(file_path), m_data(data) {}
+
+    void run() {
+      QSaveFile file(m_filePath);
+
+      if (file.open(QFile::WriteOnly) && file.write(m_data) == m_data.size()) {
+        file.commit();
+      }
+      else {
+        qWarning("Unable to write AdBlock cache file '%s'.", qPrintable(m_filePath));
+      }
+    }
+
+  private:
+    QString m_filePath;
+    QByteArray m_data;
+};
+
 AdBlockSubscription::AdBlockSubscription(QString title, QObject* parent)
   : QObject(parent), m_reply(nullptr), m_title(std::move(title)), m_updated(false) {}
 
@@ -99,16 +126,17 @@ void AdBlockSubscription::loadSubscription(const QStringList& disabledRules) {
     return;
   }
 
-  QTextStream textStream(&file);
-
-  textStream.setCodec("UTF-8");
+  const QByteArray data = file.readAll();
+  const QByteArray data_hash = QCryptographicHash::hash(data, QCryptographicHash::Algorithm::Md5);
+#if QT_VERSION >= 0x050E00 // Qt >= 5.14.0
+  const QSet<QString> disabled_rules(disabledRules.begin(), disabledRules.end());
+#else
+  const QSet<QString> disabled_rules = disabledRules.toSet();
+#endif
 
-  // Header is on 3rd line.
-  textStream.readLine(1024);
-  textStream.readLine(1024);
-  QString header = textStream.readLine(1024);
+  file.close();
 
-  if (!header.startsWith(QL1S("[Adblock")) || m_title.isEmpty()) {
+  if (m_title.isEmpty()) {
     qWarning("Invalid format of AdBlock file '%s'.", qPrintable(m_filePath));
     QTimer::singleShot(0, this, SLOT(updateSubscription()));
     return;
@@ -116,14 +144,33 @@ void AdBlockSubscription::loadSubscription(const QStringList& disabledRules) {
 
   m_rules.clear();
 
-  while (!textStream.atEnd()) {
-    AdBlockRule* rule = new AdBlockRule(textStream.readLine(), this);
+  if (!loadCachedRules(data_hash)) {
+    QTextStream textStream(data);
 
-    if (disabledRules.contains(rule->filter())) {
-      rule->setEnabled(false);
+    textStream.setCodec("UTF-8");
+
+    // Header is on 3rd line.
+    textStream.readLine(1024);
+    textStream.readLine(1024);
+    QString header = textStream.readLine(1024);
+
+    if (!header.startsWith(QL1S("[Adblock"))) {
+      qWarning("Invalid format of AdBlock file '%s'.", qPrintable(m_filePath));
+      QTimer::singleShot(0, this, SLOT(updateSubscription()));
+      return;
+    }
+
+    while (!textStream.atEnd()) {
+      m_rules.append(new AdBlockRule(textStream.readLine(), this));
     }
 
-    m_rules.append(rule);
+    saveCachedRules(data_hash);
+  }
+
+  for (AdBlockRule* rule : m_rules) {
+    if (disabled_rules.contains(rule->filter())) {
+      rule->setEnabled(false);
+    }
   }
 
   // Initial update.
@@ -134,6 +181,61 @@ void AdBlockSubscription::loadSubscription(const QStringList& disabledRules) {
 
 void AdBlockSubscription::saveSubscription() {}
 
+QString AdBlockSubscription::cacheFilePath() const {
+  return m_filePath + QSL(ADBLOCK_CACHE_SUFFIX);
+}
+
+bool AdBlockSubscription::loadCachedRules(const QByteArray& data_hash) {
+  QFile file(cacheFilePath());
+
+  if (!file.open(QFile::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  int version, count;
+  QByteArray cached_hash;
+
+  stream.setVersion(QDataStream::Version::Qt_5_6);
+  stream >> version >> cached_hash >> count;
+
+  if (stream.status() != QDataStream::Status::Ok || version != ADBLOCK_CACHE_VERSION || cached_hash != data_hash) {
+    return false;
+  }
+
+  m_rules.reserve(count);
+
+  for (int i = 0; i < count && stream.status() == QDataStream::Status::Ok; i++) {
+    m_rules.append(AdBlockRule::loadFromStream(stream, this));
+  }
+
+  if (stream.status() != QDataStream::Status::Ok) {
+    qWarning("AdBlock cache file '%s' is corrupted.", qPrintable(cacheFilePath()));
+    qDeleteAll(m_rules);
+    m_rules.clear();
+    return false;
+  }
+
+  qDebug("Loaded %d AdBlock rules of '%s' from cache.", m_rules.size(), qPrintable(m_title));
+  return true;
+}
+
+void AdBlockSubscription::saveCachedRules(const QByteArray& data_hash) const {
+  QByteArray cache_data;
+  QDataStream stream(&cache_data, QIODevice::OpenModeFlag::WriteOnly);
+
+  stream.setVersion(QDataStream::Version::Qt_5_6);
+  stream << int(ADBLOCK_CACHE_VERSION) << data_hash << m_rules.size();
+
+  for (const AdBlockRule* rule : m_rules) {
+    rule->saveToStream(stream);
+  }
+
+  // NOTE: Rules are serialized right away, because they may be
+  // changed later, only the file is written in background.
+  QThreadPool::globalInstance()->start(new AdBlockCacheWriteTask(cacheFilePath(), cache_data));
+}
+
 void AdBlockSubscription::updateSubscription() {
   if ((m_reply != nullptr) || !m_url.isValid()) {
     return;
@@ -99,6 +99,13 @@ class AdBlockSubscription : public QObject {
 
   protected:
     virtual bool saveDownloadedData(const QByteArray& data);
+
+    // Parsed rules are cached in binary file next to the subscription file,
+    // cache is valid only for subscription file with given hash.
+    QString cacheFilePath() const;
+    bool loadCachedRules(const QByteArray& data_hash);
+    void saveCachedRules(const QByteArray& data_hash) const;
+
     QNetworkReply* m_reply;
 
     QVector<AdBlockRule*> m_rules;
@@ -13,7 +13,7 @@ Downloader::Downloader(QObject* parent)
   : QObject(parent), m_activeReply(nullptr), m_downloadManager(new SilentNetworkAccessManager(this)),
   m_timer(new QTimer(this)), m_inputData(QByteArray()),
   m_inputMultipartData(nullptr), m_targetProtected(false), m_targetUsername(QString()), m_targetPassword(QString()),
-  m_lastOutputData(QByteArray()), m_lastOutputError(QNetworkReply::NoError) {
+  m_lastOutputData(QByteArray()), m_lastOutputError(QNetworkReply::NoError), m_lastHttpStatusCode(0) {
   m_timer->setInterval(DOWNLOAD_TIMEOUT);
   m_timer->setSingleShot(true);
   connect(m_timer, &QTimer::timeout, this, &Downloader::cancel);
@@ -151,6 +151,8 @@ void Downloader::finished() {
     }
 
     m_lastContentType = reply->header(QNetworkRequest::ContentTypeHeader);
+    m_lastHttpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    m_lastHeaders = reply->rawHeaderPairs();
     m_lastOutputError = reply->error();
     m_activeReply->deleteLater();
     m_activeReply = nullptr;
@@ -279,6 +281,14 @@ QVariant Downloader::lastContentType() const {
   return m_lastContentType;
 }
 
+int Downloader::lastHttpStatusCode() const {
+  return m_lastHttpStatusCode;
+}
+
+QList<QNetworkReply::RawHeaderPair> Downloader::lastHeaders() const {
+  return m_lastHeaders;
+}
+
 void Downloader::cancel() {
   if (m_activeReply != nullptr) {
     // Download action timed-out, too slow connection or target is not reachable.
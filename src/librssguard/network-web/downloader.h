@@ -29,6 +29,8 @@ class Downloader : public QObject {
     QNetworkReply::NetworkError lastOutputError() const;
     QList<HttpResponse> lastOutputMultipartData() const;
     QVariant lastContentType() const;
+    int lastHttpStatusCode() const;
+    QList<QNetworkReply::RawHeaderPair> lastHeaders() const;
 
   public slots:
     void cancel();
@@ -99,6 +101,8 @@ class Downloader : public QObject {
 
     QNetworkReply::NetworkError m_lastOutputError;
     QVariant m_lastContentType;
+    int m_lastHttpStatusCode;
+    QList<QNetworkReply::RawHeaderPair> m_lastHeaders;
 };
 
 #endif // DOWNLOADER_H
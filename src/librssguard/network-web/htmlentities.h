@@ -0,0 +1,16 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef HTMLENTITIES_H
+#define HTMLENTITIES_H
+
+// Named character reference of HTML5, value is encoded in UTF-8.
+struct HtmlEntity {
+  const char* m_name;
+  const char* m_value;
+};
+
+// All named character references defined by HTML5 (without trailing ";"), sorted by name.
+extern const HtmlEntity HTML_ENTITIES[];
+extern const int HTML_ENTITIES_COUNT;
+
+#endif // HTMLENTITIES_H
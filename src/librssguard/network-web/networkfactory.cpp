@@ -207,6 +207,37 @@ NetworkResult NetworkFactory::performNetworkOperation(const QString& url, int ti
   return result;
 }
 
+NetworkResult NetworkFactory::performGetOperation(const QString& url, int timeout, QByteArray& output,
+                                                  int& http_status_code,
+                                                  QList<QPair<QByteArray, QByteArray>>& response_headers,
+                                                  QList<QPair<QByteArray, QByteArray>> additional_headers,
+                                                  bool protected_contents,
+                                                  const QString& username, const QString& password) {
+  Downloader downloader;
+  QEventLoop loop;
+  NetworkResult result;
+
+  // We need to quit event loop when the download finishes.
+  QObject::connect(&downloader, &Downloader::completed, &loop, &QEventLoop::quit);
+
+  for (const auto& header : additional_headers) {
+    if (!header.first.isEmpty()) {
+      downloader.appendRawHeader(header.first, header.second);
+    }
+  }
+
+  downloader.manipulateData(url, QNetworkAccessManager::GetOperation, QByteArray(), timeout,
+                            protected_contents, username, password);
+  loop.exec();
+
+  output = downloader.lastOutputData();
+  http_status_code = downloader.lastHttpStatusCode();
+  response_headers = downloader.lastHeaders();
+  result.first = downloader.lastOutputError();
+  result.second = downloader.lastContentType();
+  return result;
+}
+
 NetworkResult NetworkFactory::performNetworkOperation(const QString& url,
                                                       int timeout,
                                                       QHttpMultiPart* input_data,
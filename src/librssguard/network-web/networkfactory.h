@@ -51,6 +51,18 @@ class NetworkFactory {
                                                  bool protected_contents = false,
                                                  const QString& username = QString(),
                                                  const QString& password = QString());
+
+    // Performs SYNCHRONOUS GET request, HTTP status code and headers
+    // of the response are returned too.
+    static NetworkResult performGetOperation(const QString& url, int timeout,
+                                             QByteArray& output,
+                                             int& http_status_code,
+                                             QList<QPair<QByteArray, QByteArray>>& response_headers,
+                                             QList<QPair<QByteArray,
+                                                         QByteArray>> additional_headers = QList<QPair<QByteArray, QByteArray>>(),
+                                             bool protected_contents = false,
+                                             const QString& username = QString(),
+                                             const QString& password = QString());
     static NetworkResult performNetworkOperation(const QString& url, int timeout,
                                                  QHttpMultiPart* input_data,
                                                  QList<HttpResponse>& output,
@@ -2,13 +2,18 @@
 
 #include "network-web/webfactory.h"
 
+#include "core/messagesanitizer.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
+#include "network-web/htmlentities.h"
 
 #include <QDesktopServices>
 #include <QProcess>
+#include <QStringRef>
 #include <QUrl>
 
+#include <algorithm>
+
 #if defined (USE_WEBENGINE)
 #include <QWebEngineProfile>
 #endif
@@ -66,36 +71,89 @@ bool WebFactory::openUrlInExternalBrowser(const QString& url) const {
 }
 
 QString WebFactory::stripTags(QString text) {
-  return text.remove(QRegularExpression(QSL("<[^>]*>")));
+  return MessageSanitizer::stripTags(text);
 }
 
 QString WebFactory::escapeHtml(const QString& html) {
-  if (m_escapes.isEmpty()) {
-    generateEscapes();
+  int amp = html.indexOf(QL1C('&'));
+
+  if (amp < 0) {
+    return html;
   }
 
-  QString output = html;
-  QMapIterator<QString, QString> i(m_escapes);
+  QString output;
+  int copy_from = 0;
+
+  output.reserve(html.size());
+
+  // Text is processed in single pass, so already decoded
+  // entities like "&amp;lt;" are not decoded again.
+  while (amp >= 0) {
+    int end = amp + 1;
+
+    while (end < html.size() && end - amp <= HTML_ENTITY_MAX_LENGTH &&
+           html.at(end).unicode() < 128 && (html.at(end).isLetterOrNumber() || html.at(end) == QL1C('#'))) {
+      end++;
+    }
+
+    const QString value = end < html.size() && html.at(end) == QL1C(';')
+                          ? entityValue(html.midRef(amp + 1, end - amp - 1))
+                          : QString();
 
-  while (i.hasNext()) {
-    i.next();
-    output = output.replace(i.key(), i.value());
+    if (value.isNull()) {
+      amp = html.indexOf(QL1C('&'), amp + 1);
+    }
+    else {
+      output.append(html.midRef(copy_from, amp - copy_from));
+      output.append(value);
+      copy_from = end + 1;
+      amp = html.indexOf(QL1C('&'), copy_from);
+    }
   }
 
+  output.append(html.midRef(copy_from));
   return output;
 }
 
 QString WebFactory::deEscapeHtml(const QString& text) {
-  if (m_deEscapes.isEmpty()) {
-    generateDeescapes();
-  }
+  QString output;
+
+  output.reserve(text.size());
+
+  for (const QChar chr : text) {
+    switch (chr.unicode()) {
+      case '<':
+        output.append(QL1S("&lt;"));
+        break;
+
+      case '>':
+        output.append(QL1S("&gt;"));
+        break;
+
+      case '&':
+        output.append(QL1S("&amp;"));
+        break;
 
-  QString output = text;
-  QMapIterator<QString, QString> i(m_deEscapes);
+      case '\"':
+        output.append(QL1S("&quot;"));
+        break;
 
-  while (i.hasNext()) {
-    i.next();
-    output = output.replace(i.key(), i.value());
+      case '\'':
+        output.append(QL1S("&#039;"));
+        break;
+
+      case 0x00B1:
+        output.append(QL1S("&plusmn;"));
+        break;
+
+      case 0x00D7:
+        output.append(QL1S("&times;"));
+        break;
+
+      default:
+        output.append(chr);
+        break;
+    }
   }
 
   return output;
@@ -200,23 +258,30 @@ QAction* WebFactory::createEngineSettingsAction(const QString& title, QWebEngine
 
 #endif
 
-void WebFactory::generateEscapes() {
-  m_escapes[QSL("&lt;")] = QL1C('<');
-  m_escapes[QSL("&gt;")] = QL1C('>');
-  m_escapes[QSL("&amp;")] = QL1C('&');
-  m_escapes[QSL("&quot;")] = QL1C('\"');
-  m_escapes[QSL("&nbsp;")] = QL1C(' ');
-  m_escapes[QSL("&plusmn;")] = QSL("±");
-  m_escapes[QSL("&times;")] = QSL("×");
-  m_escapes[QSL("&#039;")] = QL1C('\'');
-}
+QString WebFactory::entityValue(const QStringRef& name) {
+  if (name.startsWith(QL1C('#'))) {
+    const bool hexadecimal = name.size() > 1 && (name.at(1) == QL1C('x') || name.at(1) == QL1C('X'));
+    bool ok;
+    const uint code = name.mid(hexadecimal ? 2 : 1).toUInt(&ok, hexadecimal ? 16 : 10);
+
+    if (!ok || code == 0 || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+      return QString();
+    }
 
-void WebFactory::generateDeescapes() {
-  m_deEscapes[QSL("<")] = QSL("&lt;");
-  m_deEscapes[QSL(">")] = QSL("&gt;");
-  m_deEscapes[QSL("&")] = QSL("&amp;");
-  m_deEscapes[QSL("\"")] = QSL("&quot;");
-  m_deEscapes[QSL("±")] = QSL("&plusmn;");
-  m_deEscapes[QSL("×")] = QSL("&times;");
-  m_deEscapes[QSL("\'")] = QSL("&#039;");
+    return QString::fromUcs4(&code, 1);
+  }
+
+  const QByteArray name_latin = name.toLatin1();
+  const HtmlEntity* entities_end = HTML_ENTITIES + HTML_ENTITIES_COUNT;
+  const HtmlEntity* entity = std::lower_bound(HTML_ENTITIES, entities_end, name_latin.constData(),
+                                              [](const HtmlEntity& lhs, const char* rhs) {
+    return qstrcmp(lhs.m_name, rhs) < 0;
+  });
+
+  if (entity != entities_end && qstrcmp(entity->m_name, name_latin.constData()) == 0) {
+    return QString::fromUtf8(entity->m_value);
+  }
+  else {
+    return QString();
+  }
 }
@@ -7,8 +7,6 @@
 
 #include "core/messagesmodel.h"
 
-#include <QMap>
-
 #if defined (USE_WEBENGINE)
 #include <QWebEngineSettings>
 #endif
@@ -50,11 +48,9 @@ class WebFactory : public QObject {
 #endif
 
   private:
-    void generateEscapes();
-    void generateDeescapes();
-
-    QMap<QString, QString> m_escapes;
-    QMap<QString, QString> m_deEscapes;
+    // Returns decoded value of named or numeric character reference
+    // without "&" and ";", null string is returned for unknown references.
+    static QString entityValue(const QStringRef& name);
 
 #if defined (USE_WEBENGINE)
     QAction* m_engineSettings;
@@ -6,7 +6,30 @@
 #include "miscellaneous/mutex.h"
 
 #include <QDir>
+#include <QSaveFile>
 #include <QSet>
+#include <QThread>
+
+// Sends changes, failed synchronous sending is repeated with increasing delay.
+template<typename Sender>
+static bool sendWithRetries(Sender send, bool async) {
+  unsigned long delay = CACHE_FLUSH_RETRY_DELAY;
+
+  for (int attempt = 0; ; attempt++) {
+    QNetworkReply::NetworkError error = send();
+
+    if (error == QNetworkReply::NoError) {
+      return true;
+    }
+    else if (async || attempt >= CACHE_FLUSH_RETRIES) {
+      qWarning("Cached changes were not sent to server, network error: %d.", int(error));
+      return false;
+    }
+
+    QThread::msleep(delay);
+    delay *= 2;
+  }
+}
 
 CacheForServiceRoot::CacheForServiceRoot() : m_cacheSaveMutex(new Mutex(QMutex::NonRecursive, nullptr)) {}
 
@@ -16,7 +39,35 @@ CacheForServiceRoot::~CacheForServiceRoot() {
 
 void CacheForServiceRoot::addMessageStatesToCache(const QList<Message>& ids_of_messages, RootItem::Importance importance) {
   m_cacheSaveMutex->lock();
+  cacheImportances(ids_of_messages, importance);
+
+  if (!m_journalFile.isEmpty()) {
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+
+    stream << quint8(CACHE_JOURNAL_RECORD_IMPORTANCES) << importance << ids_of_messages;
+    appendToJournal(record);
+  }
+
+  m_cacheSaveMutex->unlock();
+}
+
+void CacheForServiceRoot::addMessageStatesToCache(const QStringList& ids_of_messages, RootItem::ReadStatus read) {
+  m_cacheSaveMutex->lock();
+  cacheReadStates(ids_of_messages, read);
+
+  if (!m_journalFile.isEmpty()) {
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+
+    stream << quint8(CACHE_JOURNAL_RECORD_READ_STATES) << read << ids_of_messages;
+    appendToJournal(record);
+  }
+
+  m_cacheSaveMutex->unlock();
+}
 
+void CacheForServiceRoot::cacheImportances(const QList<Message>& ids_of_messages, RootItem::Importance importance) {
   QList<Message>& list_act = m_cachedStatesImportant[importance];
   QList<Message>& list_other = m_cachedStatesImportant[importance == RootItem::Important ? RootItem::NotImportant : RootItem::Important];
 
@@ -37,13 +88,9 @@ void CacheForServiceRoot::addMessageStatesToCache(const QList<Message>& ids_of_m
   list_act.append(set_act.values());
   list_other.clear();
   list_other.append(set_other.values());
-
-  m_cacheSaveMutex->unlock();
 }
 
-void CacheForServiceRoot::addMessageStatesToCache(const QStringList& ids_of_messages, RootItem::ReadStatus read) {
-  m_cacheSaveMutex->lock();
-
+void CacheForServiceRoot::cacheReadStates(const QStringList& ids_of_messages, RootItem::ReadStatus read) {
   QStringList& list_act = m_cachedStatesRead[read];
   QStringList& list_other = m_cachedStatesRead[read == RootItem::Read ? RootItem::Unread : RootItem::Read];
 
@@ -64,33 +111,20 @@ void CacheForServiceRoot::addMessageStatesToCache(const QStringList& ids_of_mess
   list_act.append(set_act.values());
   list_other.clear();
   list_other.append(set_other.values());
-
-  m_cacheSaveMutex->unlock();
 }
 
 void CacheForServiceRoot::saveCacheToFile(int acc_id) {
   m_cacheSaveMutex->lock();
 
-  // Save to file.
-  const QString file_cache = qApp->userDataFolder() + QDir::separator() + QString::number(acc_id) + "-cached-msgs.dat";
-
-  if (isEmpty()) {
-    QFile::remove(file_cache);
+  if (m_journalFile.isEmpty()) {
+    m_journalFile = qApp->userDataFolder() + QDir::separator() + QString::number(acc_id) + "-cached-msgs.journal";
   }
-  else {
-    QFile file(file_cache);
 
-    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-      QDataStream stream(&file);
-
-      stream << m_cachedStatesImportant << m_cachedStatesRead;
-      file.flush();
-      file.close();
-    }
-
-    clearCache();
-  }
+  writeJournal();
+  clearCache();
 
+  // Cache is empty now, so journal must not be rewritten until it is loaded again.
+  m_journalFile.clear();
   m_cacheSaveMutex->unlock();
 }
 
@@ -103,7 +137,7 @@ void CacheForServiceRoot::loadCacheFromFile(int acc_id) {
   m_cacheSaveMutex->lock();
   clearCache();
 
-  // Load from file.
+  // Load from file in format used by older versions.
   const QString file_cache = qApp->userDataFolder() + QDir::separator() + QString::number(acc_id) + "-cached-msgs.dat";
   QFile file(file_cache);
 
@@ -119,9 +153,194 @@ void CacheForServiceRoot::loadCacheFromFile(int acc_id) {
     file.remove();
   }
 
+  m_journalFile = qApp->userDataFolder() + QDir::separator() + QString::number(acc_id) + "-cached-msgs.journal";
+  replayJournal();
+  writeJournal();
+
   m_cacheSaveMutex->unlock();
 }
 
+void CacheForServiceRoot::saveAllCachedData(bool async) {
+  QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> msg_cache = takeMessageCache();
+
+  if (msg_cache.first.isEmpty() && msg_cache.second.isEmpty()) {
+    return;
+  }
+
+  QMap<RootItem::ReadStatus, QStringList> failed_read;
+  QMap<RootItem::Importance, QList<Message>> failed_important;
+
+  // NOTE: When some chunk cannot be sent even after retries,
+  // then remaining chunks are not sent either.
+  bool sending_failed = false;
+
+  // Save the actual data read/unread.
+  for (auto i = msg_cache.first.constBegin(); i != msg_cache.first.constEnd(); i++) {
+    for (int offset = 0; offset < i.value().size(); offset += CACHE_FLUSH_CHUNK_SIZE) {
+      const QStringList chunk = i.value().mid(offset, CACHE_FLUSH_CHUNK_SIZE);
+
+      auto send = [&]() {
+        return sendMessageReadStates(i.key(), chunk, async);
+      };
+
+      if (sending_failed || !sendWithRetries(send, async)) {
+        sending_failed = true;
+        failed_read[i.key()].append(chunk);
+      }
+    }
+  }
+
+  // Save the actual data important/not important.
+  for (auto j = msg_cache.second.constBegin(); j != msg_cache.second.constEnd(); j++) {
+    for (int offset = 0; offset < j.value().size(); offset += CACHE_FLUSH_CHUNK_SIZE) {
+      const QList<Message> chunk = j.value().mid(offset, CACHE_FLUSH_CHUNK_SIZE);
+
+      auto send = [&]() {
+        return sendMessageImportances(j.key(), chunk, async);
+      };
+
+      if (sending_failed || !sendWithRetries(send, async)) {
+        sending_failed = true;
+        failed_important[j.key()].append(chunk);
+      }
+    }
+  }
+
+  m_cacheSaveMutex->lock();
+
+  // Failed changes are returned to cache unless
+  // newer change of the same message was cached meanwhile.
+  QSet<QString> newer_read;
+  QSet<Message> newer_important;
+
+  for (const QStringList& ids : m_cachedStatesRead) {
+    for (const QString& id : ids) {
+      newer_read.insert(id);
+    }
+  }
+
+  for (const QList<Message>& messages : m_cachedStatesImportant) {
+    for (const Message& message : messages) {
+      newer_important.insert(message);
+    }
+  }
+
+  for (auto i = failed_read.constBegin(); i != failed_read.constEnd(); i++) {
+    QStringList ids;
+
+    for (const QString& id : i.value()) {
+      if (!newer_read.contains(id)) {
+        ids.append(id);
+      }
+    }
+
+    if (!ids.isEmpty()) {
+      cacheReadStates(ids, i.key());
+    }
+  }
+
+  for (auto j = failed_important.constBegin(); j != failed_important.constEnd(); j++) {
+    QList<Message> messages;
+
+    for (const Message& message : j.value()) {
+      if (!newer_important.contains(message)) {
+        messages.append(message);
+      }
+    }
+
+    if (!messages.isEmpty()) {
+      cacheImportances(messages, j.key());
+    }
+  }
+
+  // Journal now contains only changes, which were not sent.
+  writeJournal();
+  m_cacheSaveMutex->unlock();
+}
+
+void CacheForServiceRoot::appendToJournal(const QByteArray& record) const {
+  QFile file(m_journalFile);
+
+  if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    file.write(record);
+    file.close();
+  }
+  else {
+    qWarning("Cannot append to journal of cached changes '%s'.", qPrintable(m_journalFile));
+  }
+}
+
+void CacheForServiceRoot::replayJournal() {
+  QFile file(m_journalFile);
+
+  if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+
+  while (!stream.atEnd()) {
+    quint8 record_type;
+
+    stream >> record_type;
+
+    if (record_type == CACHE_JOURNAL_RECORD_READ_STATES) {
+      RootItem::ReadStatus read;
+      QStringList ids_of_messages;
+
+      stream >> read >> ids_of_messages;
+
+      if (stream.status() == QDataStream::Ok) {
+        cacheReadStates(ids_of_messages, read);
+        continue;
+      }
+    }
+    else if (record_type == CACHE_JOURNAL_RECORD_IMPORTANCES) {
+      RootItem::Importance importance;
+      QList<Message> ids_of_messages;
+
+      stream >> importance >> ids_of_messages;
+
+      if (stream.status() == QDataStream::Ok) {
+        cacheImportances(ids_of_messages, importance);
+        continue;
+      }
+    }
+
+    // NOTE: Last record can be incomplete if application crashed while writing it.
+    qWarning("Journal of cached changes '%s' is damaged, rest of it is skipped.", qPrintable(m_journalFile));
+    break;
+  }
+
+  file.close();
+}
+
+void CacheForServiceRoot::writeJournal() const {
+  if (isEmpty()) {
+    QFile::remove(m_journalFile);
+    return;
+  }
+
+  QSaveFile file(m_journalFile);
+
+  if (file.open(QIODevice::WriteOnly)) {
+    QDataStream stream(&file);
+
+    for (auto i = m_cachedStatesRead.constBegin(); i != m_cachedStatesRead.constEnd(); i++) {
+      stream << quint8(CACHE_JOURNAL_RECORD_READ_STATES) << i.key() << i.value();
+    }
+
+    for (auto j = m_cachedStatesImportant.constBegin(); j != m_cachedStatesImportant.constEnd(); j++) {
+      stream << quint8(CACHE_JOURNAL_RECORD_IMPORTANCES) << j.key() << j.value();
+    }
+
+    file.commit();
+  }
+  else {
+    qWarning("Cannot write journal of cached changes '%s'.", qPrintable(m_journalFile));
+  }
+}
+
 QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> CacheForServiceRoot::takeMessageCache() {
   m_cacheSaveMutex->lock();
 
@@ -6,6 +6,7 @@
 #include "services/abstract/serviceroot.h"
 
 #include <QMap>
+#include <QNetworkReply>
 #include <QPair>
 #include <QStringList>
 
@@ -20,14 +21,23 @@ class CacheForServiceRoot {
     void addMessageStatesToCache(const QStringList& ids_of_messages, RootItem::ReadStatus read);
 
     // Persistently saves/loads cached changes to/from file.
+    // NOTE: Changes added after load are appended to journal file
+    // right away, so they survive even if application crashes.
     // NOTE: The whole cache is cleared after save is done and before load is done.
     void saveCacheToFile(int acc_id);
     void loadCacheFromFile(int acc_id);
 
-    virtual void saveAllCachedData(bool async = true) = 0;
+    // Sends all cached changes to server in chunks. If sending synchronously, then
+    // failed chunks are retried and eventually returned back to cache.
+    void saveAllCachedData(bool async = true);
 
   protected:
-    QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> takeMessageCache();
+
+    // Sends single chunk of changes to server. Asynchronous sending should report success.
+    virtual QNetworkReply::NetworkError sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids,
+                                                              bool async) = 0;
+    virtual QNetworkReply::NetworkError sendMessageImportances(RootItem::Importance importance,
+                                                               const QList<Message>& messages, bool async) = 0;
 
     Mutex* m_cacheSaveMutex;
 
@@ -35,8 +45,20 @@ class CacheForServiceRoot {
     QMap<RootItem::Importance, QList<Message>> m_cachedStatesImportant;
 
   private:
+    QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> takeMessageCache();
+
+    // These do not lock the cache.
+    void cacheReadStates(const QStringList& ids_of_messages, RootItem::ReadStatus read);
+    void cacheImportances(const QList<Message>& ids_of_messages, RootItem::Importance importance);
+    void appendToJournal(const QByteArray& record) const;
+    void replayJournal();
+    void writeJournal() const;
+
     bool isEmpty() const;
     void clearCache();
+
+    // Path to journal of changes, it is empty until cache is loaded.
+    QString m_journalFile;
 };
 
 #endif // CACHEFORSERVICEROOT_H
@@ -192,17 +192,19 @@ int Feed::updateMessages(const QList<Message>& messages, bool error_during_obtai
 
     bool anything_updated = false;
     bool ok = true;
+    MessageCountsDelta counts_delta;
+    QSqlDatabase database = is_main_thread ?
+                            qApp->database()->connection(metaObject()->className()) :
+                            qApp->database()->connection(QSL("feed_upd"));
 
     if (!messages.isEmpty()) {
       qDebug("There are some messages to be updated/added to DB.");
 
       QString custom_id = customId();
       int account_id = getParentServiceRoot()->accountId();
-      QSqlDatabase database = is_main_thread ?
-                              qApp->database()->connection(metaObject()->className()) :
-                              qApp->database()->connection(QSL("feed_upd"));
 
-      updated_messages = DatabaseQueries::updateMessages(database, messages, custom_id, account_id, url(), &anything_updated, &ok);
+      updated_messages = DatabaseQueries::updateMessages(database, messages, custom_id, account_id, url(), &anything_updated,
+                                                         &counts_delta, &ok);
     }
     else {
       qWarning("There are no messages for update.");
@@ -210,17 +212,10 @@ int Feed::updateMessages(const QList<Message>& messages, bool error_during_obtai
 
     if (ok) {
       setStatus(updated_messages > 0 ? NewMessages : Normal);
-      updateCounts(true);
+      onAfterMessagesStored(database, counts_delta);
 
-      if (getParentServiceRoot()->recycleBin() != nullptr && anything_updated) {
-        getParentServiceRoot()->recycleBin()->updateCounts(true);
-        items_to_update.append(getParentServiceRoot()->recycleBin());
-      }
-
-      if (getParentServiceRoot()->importantNode() != nullptr && anything_updated) {
-        getParentServiceRoot()->importantNode()->updateCounts(true);
-        items_to_update.append(getParentServiceRoot()->importantNode());
-      }
+      // Counts are adjusted only by stored changes, there is no need to recount them.
+      items_to_update.append(getParentServiceRoot()->applyMessageCountsDelta(counts_delta));
     }
   }
   else {
@@ -228,12 +223,23 @@ int Feed::updateMessages(const QList<Message>& messages, bool error_during_obtai
   }
 
   // Some messages were really added to DB, reload feed in model.
-  items_to_update.append(this);
+  if (!items_to_update.contains(this)) {
+    items_to_update.append(this);
+  }
   getParentServiceRoot()->itemChanged(items_to_update);
 
   return updated_messages;
 }
 
+Feed::DataChange Feed::lastDataChange() const {
+  return DataChange::Changed;
+}
+
+void Feed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  Q_UNUSED(db)
+  Q_UNUSED(counts_delta)
+}
+
 QString Feed::getAutoUpdateStatusDescription() const {
   QString auto_update_string;
 
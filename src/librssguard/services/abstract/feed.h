@@ -36,6 +36,18 @@ class Feed : public RootItem {
       OtherError = 5
     };
 
+    // Specifies whether data obtained by last call of
+    // obtainNewMessages() changed since previous update of the feed.
+    enum class DataChange {
+      Changed = 0,
+
+      // Server replied that feed was not modified.
+      NotModified = 1,
+
+      // Downloaded feed data are identical to those from previous update.
+      SameContents = 2
+    };
+
     // Constructors.
     explicit Feed(RootItem* parent = nullptr);
     explicit Feed(const QSqlRecord& record);
@@ -79,11 +91,22 @@ class Feed : public RootItem {
 
     virtual QList<Message> obtainNewMessages(bool* error_during_obtaining) = 0;
 
+    // Returns whether last call of obtainNewMessages() found out that
+    // feed was not changed since its previous update. If it was not, then
+    // returned messages are empty and they do not have to be filtered or stored.
+    virtual DataChange lastDataChange() const;
+
   public slots:
     void updateCounts(bool including_total_count);
     int updateMessages(const QList<Message>& messages, bool error_during_obtaining);
 
   protected:
+
+    // Called when messages obtained by obtainNewMessages() are
+    // successfully stored in DB, feed can persist its update state here.
+    // Feed which changes other messages in DB must add the changes to "counts_delta".
+    virtual void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
+
     QString getAutoUpdateStatusDescription() const;
     QString getStatusDescription() const;
 
@@ -75,6 +75,11 @@ bool ImportantNode::markAsReadUnread(RootItem::ReadStatus status) {
   }
 }
 
+void ImportantNode::adjustCounts(int unread_difference, int all_difference) {
+  m_unreadCount += unread_difference;
+  m_totalCount += all_difference;
+}
+
 int ImportantNode::countOfUnreadMessages() const {
   return m_unreadCount;
 }
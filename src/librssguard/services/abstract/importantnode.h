@@ -15,6 +15,9 @@ class ImportantNode : public RootItem {
     QList<Message> undeletedMessages() const;
     bool cleanMessages(bool clean_read_only);
     void updateCounts(bool including_total_count);
+
+    // Adjusts counts by given differences without recounting messages in DB.
+    void adjustCounts(int unread_difference, int all_difference);
     bool markAsReadUnread(ReadStatus status);
     int countOfUnreadMessages() const;
     int countOfAllMessages() const;
@@ -25,6 +25,11 @@ QString RecycleBin::additionalTooltip() const {
   return tr("%n deleted message(s).", nullptr, countOfAllMessages());
 }
 
+void RecycleBin::adjustCounts(int unread_difference, int all_difference) {
+  m_unreadCount += unread_difference;
+  m_totalCount += all_difference;
+}
+
 int RecycleBin::countOfUnreadMessages() const {
   return m_unreadCount;
 }
@@ -25,6 +25,9 @@ class RecycleBin : public RootItem {
 
     void updateCounts(bool update_total_count);
 
+    // Adjusts counts by given differences without recounting messages in DB.
+    void adjustCounts(int unread_difference, int all_difference);
+
   public slots:
     virtual bool empty();
     virtual bool restore();
@@ -122,6 +122,40 @@ void ServiceRoot::updateCounts(bool including_total_count) {
   }
 }
 
+QList<RootItem*> ServiceRoot::applyMessageCountsDelta(const MessageCountsDelta& delta) {
+  QList<RootItem*> changed_items;
+
+  if (!delta.m_feeds.isEmpty()) {
+    const QHash<QString, Feed*> feeds = getHashedSubTreeFeeds();
+
+    for (auto i = delta.m_feeds.constBegin(); i != delta.m_feeds.constEnd(); i++) {
+      Feed* feed = feeds.value(i.key());
+
+      if (feed != nullptr && (i.value().first != 0 || i.value().second != 0)) {
+        feed->setCountOfUnreadMessages(feed->countOfUnreadMessages() + i.value().first);
+        feed->setCountOfAllMessages(feed->countOfAllMessages() + i.value().second);
+        changed_items.append(feed);
+      }
+    }
+  }
+
+  ImportantNode* imp = importantNode();
+
+  if (imp != nullptr && delta.m_important != QPair<int, int>()) {
+    imp->adjustCounts(delta.m_important.first, delta.m_important.second);
+    changed_items.append(imp);
+  }
+
+  RecycleBin* bin = recycleBin();
+
+  if (bin != nullptr && delta.m_bin != QPair<int, int>()) {
+    bin->adjustCounts(delta.m_bin.first, delta.m_bin.second);
+    changed_items.append(bin);
+  }
+
+  return changed_items;
+}
+
 void ServiceRoot::completelyRemoveAllData() {
   // Purge old data from SQL and clean all model items.
   removeOldAccountFromDatabase(true);
@@ -227,6 +261,10 @@ bool ServiceRoot::supportsCategoryAdding() const {
   return false;
 }
 
+bool ServiceRoot::supportsConcurrentFeedUpdates() const {
+  return false;
+}
+
 void ServiceRoot::itemChanged(const QList<RootItem*>& items) {
   emit dataChanged(items);
 }
@@ -519,27 +557,21 @@ bool ServiceRoot::onBeforeSetMessagesRead(RootItem* selected_item, const QList<M
 }
 
 bool ServiceRoot::onAfterSetMessagesRead(RootItem* selected_item, const QList<Message>& messages, RootItem::ReadStatus read) {
-  Q_UNUSED(messages)
-  Q_UNUSED(read)
+  Q_UNUSED(selected_item)
 
-  QList<RootItem*> items_to_reload;
-  ImportantNode* imp = importantNode();
+  MessageCountsDelta counts_delta;
 
-  if (imp == selected_item) {
-    updateCounts(true);
-    items_to_reload << getSubTree();
-  }
-  else {
-    selected_item->updateCounts(false);
-    items_to_reload << selected_item;
-  }
+  for (const Message& message : messages) {
+    if (message.m_isRead != (read == RootItem::Read)) {
+      Message changed_message = message;
 
-  if (imp != nullptr && imp != selected_item) {
-    imp->updateCounts(true);
-    items_to_reload << imp;
+      changed_message.m_isRead = read == RootItem::Read;
+      counts_delta.removeMessage(message);
+      counts_delta.addMessage(changed_message);
+    }
   }
 
-  itemChanged(items_to_reload);
+  itemChanged(applyMessageCountsDelta(counts_delta));
   return true;
 }
 
@@ -576,17 +608,20 @@ bool ServiceRoot::onBeforeSwitchMessageImportance(RootItem* selected_item, const
 
 bool ServiceRoot::onAfterSwitchMessageImportance(RootItem* selected_item, const QList<ImportanceChange>& changes) {
   Q_UNUSED(selected_item)
-  Q_UNUSED(changes)
 
-  QList<RootItem*> items_to_reload;
-  ImportantNode* imp = importantNode();
+  MessageCountsDelta counts_delta;
 
-  if (imp != nullptr) {
-    imp->updateCounts(true);
-    items_to_reload << imp;
+  for (const ImportanceChange& change : changes) {
+    if (change.first.m_isImportant != (change.second == RootItem::Important)) {
+      Message changed_message = change.first;
+
+      changed_message.m_isImportant = change.second == RootItem::Important;
+      counts_delta.removeMessage(change.first);
+      counts_delta.addMessage(changed_message);
+    }
   }
 
-  itemChanged(items_to_reload);
+  itemChanged(applyMessageCountsDelta(counts_delta));
   return true;
 }
 
@@ -597,28 +632,24 @@ bool ServiceRoot::onBeforeMessagesDelete(RootItem* selected_item, const QList<Me
 }
 
 bool ServiceRoot::onAfterMessagesDelete(RootItem* selected_item, const QList<Message>& messages) {
-  Q_UNUSED(messages)
+  MessageCountsDelta counts_delta;
 
-  QList<RootItem*> items_to_reload;
-
-  selected_item->updateCounts(true);
-  items_to_reload << selected_item;
-
-  RecycleBin* bin = recycleBin();
-
-  if (bin != nullptr && bin != selected_item) {
-    bin->updateCounts(true);
-    items_to_reload << bin;
-  }
+  for (const Message& message : messages) {
+    Message deleted_message = message;
 
-  ImportantNode* imp = importantNode();
+    // Messages are moved to recycle bin or purged from it.
+    if (selected_item->kind() == RootItemKind::Bin) {
+      deleted_message.m_isPdeleted = true;
+    }
+    else {
+      deleted_message.m_isDeleted = true;
+    }
 
-  if (imp != nullptr && imp != selected_item) {
-    imp->updateCounts(true);
-    items_to_reload << imp;
+    counts_delta.removeMessage(message);
+    counts_delta.addMessage(deleted_message);
   }
 
-  itemChanged(items_to_reload);
+  itemChanged(applyMessageCountsDelta(counts_delta));
   return true;
 }
 
@@ -630,9 +661,18 @@ bool ServiceRoot::onBeforeMessagesRestoredFromBin(RootItem* selected_item, const
 
 bool ServiceRoot::onAfterMessagesRestoredFromBin(RootItem* selected_item, const QList<Message>& messages) {
   Q_UNUSED(selected_item)
-  Q_UNUSED(messages)
-  updateCounts(true);
-  itemChanged(getSubTree());
+
+  MessageCountsDelta counts_delta;
+
+  for (const Message& message : messages) {
+    Message restored_message = message;
+
+    restored_message.m_isDeleted = restored_message.m_isPdeleted = false;
+    counts_delta.removeMessage(message);
+    counts_delta.addMessage(restored_message);
+  }
+
+  itemChanged(applyMessageCountsDelta(counts_delta));
   return true;
 }
 
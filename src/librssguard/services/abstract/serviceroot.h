@@ -45,6 +45,12 @@ class ServiceRoot : public RootItem {
     virtual bool supportsFeedAdding() const;
     virtual bool supportsCategoryAdding() const;
 
+    // Returns true if feeds of this service can be downloaded in parallel,
+    // for example because each feed is downloaded from its own URL.
+    // Feeds of services which share one network session are downloaded
+    // one by one.
+    virtual bool supportsConcurrentFeedUpdates() const;
+
     // Returns list of specific actions for "Add new item" main window menu.
     // So typical list of returned actions could look like:
     //  a) Add new feed
@@ -84,6 +90,10 @@ class ServiceRoot : public RootItem {
 
     void completelyRemoveAllData();
     QStringList customIDSOfMessagesForItem(RootItem* item);
+
+    // Adjusts counts of feeds, recycle bin and important messages
+    // without recounting messages in DB. Returns items with changed counts.
+    QList<RootItem*> applyMessageCountsDelta(const MessageCountsDelta& delta);
     bool markFeedsReadUnread(QList<Feed*> items, ReadStatus read);
 
     // Obvious methods to wrap signals.
@@ -0,0 +1,107 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "services/abstract/syncforserviceroot.h"
+
+#include <QMutexLocker>
+
+SyncForServiceRoot::SyncForServiceRoot()
+  : m_syncWholeAccount(false), m_syncDownloaded(false), m_syncCursor(0), m_storedSyncCursor(0) {}
+
+void SyncForServiceRoot::startSync(const QStringList& feed_custom_ids, const QStringList& account_feed_custom_ids) {
+  QMutexLocker locker(&m_syncMutex);
+
+  if (!m_syncedMessages.isEmpty() || !m_unstoredFeeds.isEmpty()) {
+    // Some messages of previous update were not stored, so the
+    // cursor is returned back and they are downloaded again.
+    qDebug("Previous synchronization of messages was not finished, cursor is reset to %lld.", m_storedSyncCursor);
+
+    m_syncCursor = m_storedSyncCursor;
+    m_syncedMessages.clear();
+    m_unstoredFeeds.clear();
+  }
+
+  m_syncedFeeds = feed_custom_ids;
+  m_syncedFeeds.removeDuplicates();
+  m_syncDownloaded = false;
+  m_syncWholeAccount = !m_syncedFeeds.isEmpty();
+
+  for (const QString& account_feed : account_feed_custom_ids) {
+    if (!m_syncedFeeds.contains(account_feed)) {
+      m_syncWholeAccount = false;
+      break;
+    }
+  }
+}
+
+QList<Message> SyncForServiceRoot::takeSyncedMessages(const QString& feed_custom_id, Feed::Status& error) {
+  QMutexLocker locker(&m_syncMutex);
+
+  if (!m_syncWholeAccount) {
+    // Messages of other feeds would be skipped by the cursor, so
+    // only messages of this feed are obtained and cursor is kept.
+    QList<Message> messages;
+
+    error = downloadFeedMessages(feed_custom_id, messages);
+    return error == Feed::Status::Normal ? messages : QList<Message>();
+  }
+
+  if (!m_syncDownloaded) {
+    QList<Message> messages;
+    qint64 new_cursor = m_syncCursor;
+
+    error = downloadSyncedMessages(m_syncCursor, m_syncedFeeds, messages, new_cursor);
+
+    if (error != Feed::Status::Normal) {
+      // Next feed of this update will try to download messages again.
+      return QList<Message>();
+    }
+
+    for (const QString& synced_feed : m_syncedFeeds) {
+      m_syncedMessages.insert(synced_feed, QList<Message>());
+    }
+
+    for (const Message& msg : messages) {
+      auto feed_messages = m_syncedMessages.find(msg.m_feedId);
+
+      if (feed_messages != m_syncedMessages.end()) {
+        feed_messages->append(msg);
+      }
+    }
+
+    m_syncCursor = qMax(m_syncCursor, new_cursor);
+    m_syncDownloaded = true;
+  }
+
+  if (m_syncedMessages.contains(feed_custom_id)) {
+    m_unstoredFeeds.insert(feed_custom_id);
+  }
+
+  error = Feed::Status::Normal;
+  return m_syncedMessages.take(feed_custom_id);
+}
+
+void SyncForServiceRoot::onAfterSyncedMessagesStored(const QSqlDatabase& db, const QString& feed_custom_id) {
+  QMutexLocker locker(&m_syncMutex);
+
+  m_unstoredFeeds.remove(feed_custom_id);
+
+  if (m_syncDownloaded && m_syncedMessages.isEmpty() && m_unstoredFeeds.isEmpty() &&
+      m_syncCursor != m_storedSyncCursor && storeSyncCursor(db, m_syncCursor)) {
+    m_storedSyncCursor = m_syncCursor;
+  }
+}
+
+void SyncForServiceRoot::setSyncCursor(qint64 cursor) {
+  QMutexLocker locker(&m_syncMutex);
+
+  m_syncCursor = m_storedSyncCursor = cursor;
+  m_syncDownloaded = false;
+  m_syncedMessages.clear();
+  m_unstoredFeeds.clear();
+}
+
+qint64 SyncForServiceRoot::syncCursor() const {
+  QMutexLocker locker(&m_syncMutex);
+
+  return m_syncCursor;
+}
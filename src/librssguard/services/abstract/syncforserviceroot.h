@@ -0,0 +1,73 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef SYNCFORSERVICEROOT_H
+#define SYNCFORSERVICEROOT_H
+
+#include "services/abstract/feed.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QStringList>
+
+// Synchronizes messages of all feeds of account by single download. Each
+// feed then takes its own messages from the downloaded ones.
+//
+// Service remembers cursor (for example time of newest message) of last download,
+// next downloads obtain only messages changed since that cursor. Cursor is persisted
+// only when messages of all feeds of current update are stored in DB.
+//
+// Cursor is shared by all feeds, so it is moved only when all feeds of the account are
+// updated together. Feeds of partial updates download their messages one by one.
+class RSSGUARD_DLLSPEC SyncForServiceRoot {
+  public:
+    explicit SyncForServiceRoot();
+    virtual ~SyncForServiceRoot() = default;
+
+    // Called before given feeds of this account are updated, "account_feed_custom_ids"
+    // are all feeds of the account.
+    // NOTE: If previous update was not finished, then its messages
+    // are dropped and they are downloaded again.
+    void startSync(const QStringList& feed_custom_ids, const QStringList& account_feed_custom_ids);
+
+    // Returns messages of given feed. When whole account is updated, messages of
+    // all feeds are downloaded when first feed asks for them.
+    QList<Message> takeSyncedMessages(const QString& feed_custom_id, Feed::Status& error);
+    void onAfterSyncedMessagesStored(const QSqlDatabase& db, const QString& feed_custom_id);
+
+    // Sets cursor loaded from DB, all messages which were not taken yet are dropped.
+    void setSyncCursor(qint64 cursor);
+    qint64 syncCursor() const;
+
+  protected:
+
+    // Downloads messages of given feeds changed since given cursor, cursor
+    // lower than one means that initial synchronization is done.
+    virtual Feed::Status downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                                QList<Message>& messages, qint64& new_cursor) = 0;
+
+    // Downloads messages of single feed without using the cursor.
+    virtual Feed::Status downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages) = 0;
+    virtual bool storeSyncCursor(const QSqlDatabase& db, qint64 cursor) = 0;
+
+  private:
+    mutable QMutex m_syncMutex;
+
+    // Feeds of current update, messages are downloaded once per update
+    // if the update contains all feeds of the account.
+    QStringList m_syncedFeeds;
+    bool m_syncWholeAccount;
+    bool m_syncDownloaded;
+
+    // Downloaded messages, which were not taken by their feeds yet,
+    // and feeds, which took their messages but did not store them yet.
+    QHash<QString, QList<Message>> m_syncedMessages;
+    QSet<QString> m_unstoredFeeds;
+
+    // Cursor of last download and cursor stored in DB.
+    qint64 m_syncCursor;
+    qint64 m_storedSyncCursor;
+};
+
+#endif // SYNCFORSERVICEROOT_H
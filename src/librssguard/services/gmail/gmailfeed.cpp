@@ -3,6 +3,7 @@
 #include "services/gmail/gmailfeed.h"
 
 #include "miscellaneous/application.h"
+#include "miscellaneous/databasequeries.h"
 #include "miscellaneous/iconfactory.h"
 #include "services/gmail/definitions.h"
 #include "services/gmail/gmailserviceroot.h"
@@ -38,9 +39,13 @@ GmailServiceRoot* GmailFeed::serviceRoot() const {
 
 QList<Message> GmailFeed::obtainNewMessages(bool* error_during_obtaining) {
   Feed::Status error = Feed::Status::Normal;
-  QList<Message> messages = serviceRoot()->network()->messages(customId(), error);
+  QList<Message> known_messages;
+  QList<Message> messages = serviceRoot()->network()->messages(customId(), serviceRoot()->knownMessageIds(customId()),
+                                                               known_messages, error);
 
   setStatus(error);
+  m_pendingNewMessages = messages;
+  m_pendingKnownMessages = known_messages;
 
   if (error == Feed::Status::NetworkError || error == Feed::Status::AuthError || error == Feed::Status::ParsingError) {
     *error_during_obtaining = true;
@@ -48,3 +53,36 @@ QList<Message> GmailFeed::obtainNewMessages(bool* error_during_obtaining) {
 
   return messages;
 }
+
+void GmailFeed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  QStringList missing_custom_ids;
+
+  if (!DatabaseQueries::updateMessageStatesByCustomIds(db, m_pendingKnownMessages, serviceRoot()->accountId(),
+                                                       &counts_delta, &missing_custom_ids)) {
+    qWarning("Gmail: Failed to synchronize states of messages of label '%s'.", qPrintable(customId()));
+  }
+
+  // Messages which were purged from DB in the meantime are downloaded in full next time.
+  serviceRoot()->removeKnownMessageIds(missing_custom_ids);
+
+  // Filters may reject some new messages, only those really stored are known.
+  QStringList new_custom_ids;
+  bool ok;
+
+  for (const Message& message : m_pendingNewMessages) {
+    new_custom_ids.append(message.m_customId);
+  }
+
+  const QStringList stored_custom_ids = DatabaseQueries::customIdsOfExistingMessages(db, new_custom_ids,
+                                                                                     serviceRoot()->accountId(), &ok);
+
+  if (ok) {
+    serviceRoot()->addKnownMessageIds(customId(), stored_custom_ids);
+  }
+  else {
+    qWarning("Gmail: Failed to check which messages of label '%s' were stored.", qPrintable(customId()));
+  }
+
+  m_pendingNewMessages.clear();
+  m_pendingKnownMessages.clear();
+}
@@ -15,6 +15,15 @@ class GmailFeed : public Feed {
 
     GmailServiceRoot* serviceRoot() const;
     QList<Message> obtainNewMessages(bool* error_during_obtaining);
+
+  protected:
+    void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
+
+  private:
+
+    // Results of last download, which are applied after messages are stored.
+    QList<Message> m_pendingNewMessages;
+    QList<Message> m_pendingKnownMessages;
 };
 
 #endif // GMAILFEED_H
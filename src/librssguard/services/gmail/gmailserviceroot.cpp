@@ -72,6 +72,45 @@ void GmailServiceRoot::loadFromDatabase() {
   appendChild(recycleBin());
   appendChild(importantNode());
   updateCounts(true);
+
+  QMutexLocker locker(&m_knownMessageIdsMutex);
+
+  m_knownMessageIds.clear();
+
+  for (const Feed* feed : getSubTreeFeeds()) {
+    const QStringList custom_ids = DatabaseQueries::customIdsOfMessagesFromFeed(database, feed->customId(), accountId());
+
+#if QT_VERSION >= 0x050E00 // Qt >= 5.14.0
+    m_knownMessageIds.insert(feed->customId(), QSet<QString>(custom_ids.begin(), custom_ids.end()));
+#else
+    m_knownMessageIds.insert(feed->customId(), custom_ids.toSet());
+#endif
+  }
+}
+
+QSet<QString> GmailServiceRoot::knownMessageIds(const QString& label) const {
+  QMutexLocker locker(&m_knownMessageIdsMutex);
+
+  return m_knownMessageIds.value(label);
+}
+
+void GmailServiceRoot::addKnownMessageIds(const QString& label, const QStringList& custom_ids) {
+  QMutexLocker locker(&m_knownMessageIdsMutex);
+  QSet<QString>& label_ids = m_knownMessageIds[label];
+
+  for (const QString& custom_id : custom_ids) {
+    label_ids.insert(custom_id);
+  }
+}
+
+void GmailServiceRoot::removeKnownMessageIds(const QStringList& custom_ids) {
+  QMutexLocker locker(&m_knownMessageIdsMutex);
+
+  for (QSet<QString>& label_ids : m_knownMessageIds) {
+    for (const QString& custom_id : custom_ids) {
+      label_ids.remove(custom_id);
+    }
+  }
 }
 
 void GmailServiceRoot::saveAccountDataToDatabase() {
@@ -186,39 +225,14 @@ QString GmailServiceRoot::additionalTooltip() const {
                                                network()->oauth()->tokensExpireIn().toString() : QSL("-"));
 }
 
-void GmailServiceRoot::saveAllCachedData(bool async) {
-  QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> msgCache = takeMessageCache();
-  QMapIterator<RootItem::ReadStatus, QStringList> i(msgCache.first);
-
-  // Save the actual data read/unread.
-  while (i.hasNext()) {
-    i.next();
-    auto key = i.key();
-    QStringList ids = i.value();
-
-    if (!ids.isEmpty()) {
-      network()->markMessagesRead(key, ids, async);
-    }
-  }
-
-  QMapIterator<RootItem::Importance, QList<Message>> j(msgCache.second);
-
-  // Save the actual data important/not important.
-  while (j.hasNext()) {
-    j.next();
-    auto key = j.key();
-    QList<Message> messages = j.value();
-
-    if (!messages.isEmpty()) {
-      QStringList custom_ids;
-
-      for (const Message& msg : messages) {
-        custom_ids.append(msg.m_customId);
-      }
+QNetworkReply::NetworkError GmailServiceRoot::sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids,
+                                                                    bool async) {
+  return network()->markMessagesRead(read, custom_ids, async);
+}
 
-      network()->markMessagesStarred(key, custom_ids, async);
-    }
-  }
+QNetworkReply::NetworkError GmailServiceRoot::sendMessageImportances(RootItem::Importance importance,
+                                                                     const QList<Message>& messages, bool async) {
+  return network()->markMessagesStarred(importance, customIDsOfMessages(messages), async);
 }
 
 bool GmailServiceRoot::canBeDeleted() const {
@@ -6,6 +6,10 @@
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/serviceroot.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
 class GmailNetworkFactory;
 
 class GmailServiceRoot : public ServiceRoot, public CacheForServiceRoot {
@@ -35,12 +39,21 @@ class GmailServiceRoot : public ServiceRoot, public CacheForServiceRoot {
 
     QString additionalTooltip() const;
 
-    void saveAllCachedData(bool async = true);
+    // IDs of messages of given label stored in DB, these are not downloaded in full again.
+    QSet<QString> knownMessageIds(const QString& label) const;
+    void addKnownMessageIds(const QString& label, const QStringList& custom_ids);
+
+    // Removes IDs of messages, which are not in DB anymore, from all labels.
+    void removeKnownMessageIds(const QStringList& custom_ids);
 
   public slots:
     void updateTitle();
 
   protected:
+    QNetworkReply::NetworkError sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids, bool async);
+    QNetworkReply::NetworkError sendMessageImportances(RootItem::Importance importance, const QList<Message>& messages,
+                                                       bool async);
+
     RootItem* obtainNewTreeForSyncIn() const;
 
   private:
@@ -51,6 +64,8 @@ class GmailServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     QList<QAction*> m_serviceMenu;
     GmailNetworkFactory* m_network;
 
+    mutable QMutex m_knownMessageIdsMutex;
+    QHash<QString, QSet<QString>> m_knownMessageIds;
 };
 
 inline void GmailServiceRoot::setNetwork(GmailNetworkFactory* network) {
@@ -133,7 +133,8 @@ Downloader* GmailNetworkFactory::downloadAttachment(const QString& msg_id, const
   }
 }
 
-QList<Message> GmailNetworkFactory::messages(const QString& stream_id, Feed::Status& error) {
+QList<Message> GmailNetworkFactory::messages(const QString& stream_id, const QSet<QString>& known_ids,
+                                             QList<Message>& known_messages, Feed::Status& error) {
   Downloader downloader;
   QEventLoop loop;
   QString bearer = m_oauth2->bearer().toLocal8Bit();
@@ -170,16 +171,22 @@ QList<Message> GmailNetworkFactory::messages(const QString& stream_id, Feed::Sta
       // We parse this chunk.
       QString messages_data = downloader.lastOutputData();
       QList<Message> more_messages = decodeLiteMessages(messages_data, stream_id, next_page_token);
-      QList<Message> full_messages;
+      QList<Message> new_messages, stored_messages, full_messages;
 
-      // Now, we via batch HTTP request obtain full data for each message.
-      bool obtained = obtainAndDecodeFullMessages(more_messages, stream_id, full_messages);
+      for (const Message& msg : more_messages) {
+        (known_ids.contains(msg.m_customId) ? stored_messages : new_messages).append(msg);
+      }
+
+      // Now, we via batch HTTP request obtain full data for each new message
+      // and only labels for messages, which are already stored.
+      bool obtained = obtainAndDecodeFullMessages(new_messages, stream_id, full_messages) &&
+                      obtainAndDecodeFullMessages(stored_messages, stream_id, known_messages, true);
 
       if (obtained) {
         messages.append(full_messages);
 
         // New batch of messages was obtained, check if we have enough.
-        if (batchSize() > 0 && batchSize() <= messages.size()) {
+        if (batchSize() > 0 && batchSize() <= messages.size() + known_messages.size()) {
           // We have enough messages.
           break;
         }
@@ -200,11 +207,12 @@ QList<Message> GmailNetworkFactory::messages(const QString& stream_id, Feed::Sta
   return messages;
 }
 
-void GmailNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async) {
+QNetworkReply::NetworkError GmailNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids,
+                                                              bool async) {
   QString bearer = m_oauth2->bearer().toLocal8Bit();
 
   if (bearer.isEmpty()) {
-    return;
+    return QNetworkReply::AuthenticationRequiredError;
   }
 
   QList<QPair<QByteArray, QByteArray>> headers;
@@ -240,24 +248,27 @@ void GmailNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QS
                                                  param_doc.toJson(QJsonDocument::JsonFormat::Compact),
                                                  QNetworkAccessManager::Operation::PostOperation,
                                                  headers);
+
+    return QNetworkReply::NoError;
   }
   else {
     QByteArray output;
 
-    NetworkFactory::performNetworkOperation(GMAIL_API_BATCH_UPD_LABELS,
-                                            timeout,
-                                            param_doc.toJson(QJsonDocument::JsonFormat::Compact),
-                                            output,
-                                            QNetworkAccessManager::Operation::PostOperation,
-                                            headers);
+    return NetworkFactory::performNetworkOperation(GMAIL_API_BATCH_UPD_LABELS,
+                                                   timeout,
+                                                   param_doc.toJson(QJsonDocument::JsonFormat::Compact),
+                                                   output,
+                                                   QNetworkAccessManager::Operation::PostOperation,
+                                                   headers).first;
   }
 }
 
-void GmailNetworkFactory::markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids, bool async) {
+QNetworkReply::NetworkError GmailNetworkFactory::markMessagesStarred(RootItem::Importance importance,
+                                                                 const QStringList& custom_ids, bool async) {
   QString bearer = m_oauth2->bearer().toLocal8Bit();
 
   if (bearer.isEmpty()) {
-    return;
+    return QNetworkReply::AuthenticationRequiredError;
   }
 
   QList<QPair<QByteArray, QByteArray>> headers;
@@ -293,16 +304,18 @@ void GmailNetworkFactory::markMessagesStarred(RootItem::Importance importance, c
                                                  param_doc.toJson(QJsonDocument::JsonFormat::Compact),
                                                  QNetworkAccessManager::Operation::PostOperation,
                                                  headers);
+
+    return QNetworkReply::NoError;
   }
   else {
     QByteArray output;
 
-    NetworkFactory::performNetworkOperation(GMAIL_API_BATCH_UPD_LABELS,
-                                            timeout,
-                                            param_doc.toJson(QJsonDocument::JsonFormat::Compact),
-                                            output,
-                                            QNetworkAccessManager::Operation::PostOperation,
-                                            headers);
+    return NetworkFactory::performNetworkOperation(GMAIL_API_BATCH_UPD_LABELS,
+                                                   timeout,
+                                                   param_doc.toJson(QJsonDocument::JsonFormat::Compact),
+                                                   output,
+                                                   QNetworkAccessManager::Operation::PostOperation,
+                                                   headers).first;
   }
 }
 
@@ -330,13 +343,7 @@ void GmailNetworkFactory::onAuthFailed() {
   });
 }
 
-bool GmailNetworkFactory::fillFullMessage(Message& msg, const QJsonObject& json, const QString& feed_id) {
-  QHash<QString, QString> headers;
-
-  for (const QJsonValue& header : json["payload"].toObject()["headers"].toArray()) {
-    headers.insert(header.toObject()["name"].toString(), header.toObject()["value"].toString());
-  }
-
+bool GmailNetworkFactory::fillMessageStates(Message& msg, const QJsonObject& json, const QString& feed_id) {
   msg.m_isRead = true;
 
   // Assign correct main labels/states.
@@ -366,6 +373,20 @@ bool GmailNetworkFactory::fillFullMessage(Message& msg, const QJsonObject& json,
     }
   }
 
+  return true;
+}
+
+bool GmailNetworkFactory::fillFullMessage(Message& msg, const QJsonObject& json, const QString& feed_id) {
+  if (!fillMessageStates(msg, json, feed_id)) {
+    return false;
+  }
+
+  QHash<QString, QString> headers;
+
+  for (const QJsonValue& header : json["payload"].toObject()["headers"].toArray()) {
+    headers.insert(header.toObject()["name"].toString(), header.toObject()["value"].toString());
+  }
+
   msg.m_author = headers["From"];
   msg.m_title = headers["Subject"];
   msg.m_createdFromFeed = true;
@@ -503,7 +524,12 @@ QStringList GmailNetworkFactory::getAllRecipients() {
 
 bool GmailNetworkFactory::obtainAndDecodeFullMessages(const QList<Message>& lite_messages,
                                                       const QString& feed_id,
-                                                      QList<Message>& full_messages) {
+                                                      QList<Message>& full_messages,
+                                                      bool states_only) {
+  if (lite_messages.isEmpty()) {
+    return true;
+  }
+
   auto* multi = new QHttpMultiPart();
 
   multi->setContentType(QHttpMultiPart::ContentType::MixedType);
@@ -514,7 +540,10 @@ bool GmailNetworkFactory::obtainAndDecodeFullMessages(const QList<Message>& lite
     QHttpPart part;
 
     part.setRawHeader(HTTP_HEADERS_CONTENT_TYPE, GMAIL_CONTENT_TYPE_HTTP);
-    QString full_msg_endpoint = QString("GET /gmail/v1/users/me/messages/%1\r\n").arg(msg.m_customId);
+    QString full_msg_endpoint = QString("GET /gmail/v1/users/me/messages/%1%2\r\n").arg(msg.m_customId,
+                                                                                      states_only
+                                                                                      ? QSL("?format=minimal")
+                                                                                      : QString());
 
     part.setBody(full_msg_endpoint.toUtf8());
     multi->append(part);
@@ -550,7 +579,7 @@ bool GmailNetworkFactory::obtainAndDecodeFullMessages(const QList<Message>& lite
       if (msgs.contains(msg_id)) {
         Message& msg = msgs[msg_id];
 
-        if (fillFullMessage(msg, msg_doc, feed_id)) {
+        if (states_only ? fillMessageStates(msg, msg_doc, feed_id) : fillFullMessage(msg, msg_doc, feed_id)) {
           full_messages.append(msg);
         }
       }
@@ -12,6 +12,7 @@
 #include "services/abstract/rootitem.h"
 
 #include <QNetworkReply>
+#include <QSet>
 
 class RootItem;
 class GmailServiceRoot;
@@ -43,17 +44,23 @@ class GmailNetworkFactory : public QObject {
 
     Downloader* downloadAttachment(const QString& msg_id, const QString& attachment_id);
 
-    QList<Message> messages(const QString& stream_id, Feed::Status& error);
-    void markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
-    void markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids, bool async = true);
+    // Obtains messages of given label. Only states of messages with ID
+    // in "known_ids" are obtained, they are returned in "known_messages".
+    QList<Message> messages(const QString& stream_id, const QSet<QString>& known_ids,
+                            QList<Message>& known_messages, Feed::Status& error);
+    QNetworkReply::NetworkError markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
+    QNetworkReply::NetworkError markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids,
+                                                    bool async = true);
 
   private slots:
     void onTokensError(const QString& error, const QString& error_description);
     void onAuthFailed();
 
   private:
+    bool fillMessageStates(Message& msg, const QJsonObject& json, const QString& feed_id);
     bool fillFullMessage(Message& msg, const QJsonObject& json, const QString& feed_id);
-    bool obtainAndDecodeFullMessages(const QList<Message>& lite_messages, const QString& feed_id, QList<Message>& full_messages);
+    bool obtainAndDecodeFullMessages(const QList<Message>& lite_messages, const QString& feed_id,
+                                     QList<Message>& full_messages, bool states_only = false);
     QList<Message> decodeLiteMessages(const QString& messages_json_data, const QString& stream_id, QString& next_page_token);
 
     //RootItem* decodeFeedCategoriesData(const QString& categories);
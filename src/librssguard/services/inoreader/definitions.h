@@ -18,6 +18,13 @@
 #define INOREADER_MAX_BATCH_SIZE        999
 #define INOREADER_MIN_BATCH_SIZE        20
 
+// Max number of items returned by single stream request.
+#define INOREADER_MAX_STREAM_ITEMS      1000
+
+// Number of hours after which newest messages are downloaded
+// again to refresh their states instead of incremental download.
+#define INOREADER_FULL_SYNC_INTERVAL    24
+
 #define INOREADER_STATE_READING_LIST    "state/com.google/reading-list"
 #define INOREADER_STATE_READ            "state/com.google/read"
 #define INOREADER_STATE_IMPORTANT       "state/com.google/starred"
@@ -17,7 +17,7 @@ InoreaderServiceRoot* InoreaderFeed::serviceRoot() const {
 
 QList<Message> InoreaderFeed::obtainNewMessages(bool* error_during_obtaining) {
   Feed::Status error = Feed::Status::Normal;
-  QList<Message> messages = serviceRoot()->network()->messages(customId(), error);
+  QList<Message> messages = serviceRoot()->takeSyncedMessages(customId(), error);
 
   setStatus(error);
 
@@ -27,3 +27,9 @@ QList<Message> InoreaderFeed::obtainNewMessages(bool* error_during_obtaining) {
 
   return messages;
 }
+
+void InoreaderFeed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  Q_UNUSED(counts_delta)
+
+  serviceRoot()->onAfterSyncedMessagesStored(db, customId());
+}
@@ -14,6 +14,9 @@ class InoreaderFeed : public Feed {
 
     InoreaderServiceRoot* serviceRoot() const;
     QList<Message> obtainNewMessages(bool* error_during_obtaining);
+
+  protected:
+    void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
 };
 
 #endif // INOREADERFEED_H
@@ -8,6 +8,7 @@
 #include "network-web/oauth2service.h"
 #include "services/abstract/importantnode.h"
 #include "services/abstract/recyclebin.h"
+#include "services/inoreader/definitions.h"
 #include "services/inoreader/gui/formeditinoreaderaccount.h"
 #include "services/inoreader/inoreaderentrypoint.h"
 #include "services/inoreader/inoreaderfeed.h"
@@ -58,6 +59,7 @@ void InoreaderServiceRoot::saveAccountDataToDatabase() {
                                                    m_network->oauth()->refreshToken(),
                                                    m_network->batchSize(),
                                                    accountId())) {
+      setSyncCursor(0);
       updateTitle();
       itemChanged(QList<RootItem*>() << this);
     }
@@ -141,6 +143,47 @@ QString InoreaderServiceRoot::additionalTooltip() const {
                                                network()->oauth()->tokensExpireIn().toString() : QSL("-"));
 }
 
+Feed::Status InoreaderServiceRoot::downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                                         QList<Message>& messages, qint64& new_cursor) {
+  // Only messages newer than last synchronization are obtained, except for
+  // periodic full synchronization which refreshes states of newest messages.
+  const QDateTime current_time = QDateTime::currentDateTimeUtc();
+  const bool full_sync = cursor <= 0 || !m_lastFullSync.isValid() ||
+                         m_lastFullSync.secsTo(current_time) >= INOREADER_FULL_SYNC_INTERVAL * 3600;
+  const int batch_size = m_network->batchSize() <= 0 ? INOREADER_DEFAULT_BATCH_SIZE : m_network->batchSize();
+  Feed::Status error = Feed::Status::Normal;
+
+  messages = m_network->messages(QSL("user/-/") + INOREADER_STATE_READING_LIST,
+                                 full_sync ? 0 : cursor,
+                                 full_sync ? batch_size * qMax(1, feed_custom_ids.size()) : 0,
+                                 new_cursor, error);
+
+  if (error != Feed::Status::Normal) {
+    return error;
+  }
+
+  if (full_sync) {
+    m_lastFullSync = current_time;
+  }
+
+  qDebug("Inoreader: Obtained %d messages of account %d using %s synchronization.",
+         messages.size(), accountId(), full_sync ? "full" : "incremental");
+  return Feed::Status::Normal;
+}
+
+Feed::Status InoreaderServiceRoot::downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages) {
+  const int batch_size = m_network->batchSize() <= 0 ? INOREADER_DEFAULT_BATCH_SIZE : m_network->batchSize();
+  Feed::Status error = Feed::Status::Normal;
+  qint64 newest_timestamp = 0;
+
+  messages = m_network->messages(feed_custom_id, 0, batch_size, newest_timestamp, error);
+  return error;
+}
+
+bool InoreaderServiceRoot::storeSyncCursor(const QSqlDatabase& db, qint64 cursor) {
+  return DatabaseQueries::storeInoreaderLastSync(db, cursor, accountId());
+}
+
 RootItem* InoreaderServiceRoot::obtainNewTreeForSyncIn() const {
   return m_network->feedsCategories(true);
 }
@@ -151,39 +194,14 @@ void InoreaderServiceRoot::addNewFeed(const QString& url) {
 
 void InoreaderServiceRoot::addNewCategory() {}
 
-void InoreaderServiceRoot::saveAllCachedData(bool async) {
-  QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> msgCache = takeMessageCache();
-  QMapIterator<RootItem::ReadStatus, QStringList> i(msgCache.first);
-
-  // Save the actual data read/unread.
-  while (i.hasNext()) {
-    i.next();
-    auto key = i.key();
-    QStringList ids = i.value();
-
-    if (!ids.isEmpty()) {
-      network()->markMessagesRead(key, ids, async);
-    }
-  }
-
-  QMapIterator<RootItem::Importance, QList<Message>> j(msgCache.second);
-
-  // Save the actual data important/not important.
-  while (j.hasNext()) {
-    j.next();
-    auto key = j.key();
-    QList<Message> messages = j.value();
-
-    if (!messages.isEmpty()) {
-      QStringList custom_ids;
-
-      for (const Message& msg : messages) {
-        custom_ids.append(msg.m_customId);
-      }
+QNetworkReply::NetworkError InoreaderServiceRoot::sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids,
+                                                                        bool async) {
+  return network()->markMessagesRead(read, custom_ids, async);
+}
 
-      network()->markMessagesStarred(key, custom_ids, async);
-    }
-  }
+QNetworkReply::NetworkError InoreaderServiceRoot::sendMessageImportances(RootItem::Importance importance,
+                                                                         const QList<Message>& messages, bool async) {
+  return network()->markMessagesStarred(importance, customIDsOfMessages(messages), async);
 }
 
 bool InoreaderServiceRoot::canBeDeleted() const {
@@ -5,10 +5,13 @@
 
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/serviceroot.h"
+#include "services/abstract/syncforserviceroot.h"
+
+#include <QDateTime>
 
 class InoreaderNetworkFactory;
 
-class InoreaderServiceRoot : public ServiceRoot, public CacheForServiceRoot {
+class InoreaderServiceRoot : public ServiceRoot, public CacheForServiceRoot, public SyncForServiceRoot {
   Q_OBJECT
 
   public:
@@ -34,13 +37,22 @@ class InoreaderServiceRoot : public ServiceRoot, public CacheForServiceRoot {
 
     RootItem* obtainNewTreeForSyncIn() const;
 
-    void saveAllCachedData(bool async = true);
-
   public slots:
     void addNewFeed(const QString& url);
     void addNewCategory();
     void updateTitle();
 
+  protected:
+    QNetworkReply::NetworkError sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids, bool async);
+    QNetworkReply::NetworkError sendMessageImportances(RootItem::Importance importance, const QList<Message>& messages,
+                                                       bool async);
+
+    // Messages are downloaded from reading list stream, cursor is arrival time of newest downloaded message.
+    Feed::Status downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                        QList<Message>& messages, qint64& new_cursor);
+    Feed::Status downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages);
+    bool storeSyncCursor(const QSqlDatabase& db, qint64 cursor);
+
   private:
     void loadFromDatabase();
     QList<QAction*> serviceMenu();
@@ -48,6 +60,10 @@ class InoreaderServiceRoot : public ServiceRoot, public CacheForServiceRoot {
   private:
     QList<QAction*> m_serviceMenu;
     InoreaderNetworkFactory* m_network;
+
+    // NOTE: Time of last full synchronization is not persisted,
+    // so first update after start of application is always full.
+    QDateTime m_lastFullSync;
 };
 
 inline void InoreaderServiceRoot::setNetwork(InoreaderNetworkFactory* network) {
@@ -106,10 +106,8 @@ RootItem* InoreaderNetworkFactory::feedsCategories(bool obtain_icons) {
   return decodeFeedCategoriesData(category_data, feed_data, obtain_icons);
 }
 
-QList<Message> InoreaderNetworkFactory::messages(const QString& stream_id, Feed::Status& error) {
-  Downloader downloader;
-  QEventLoop loop;
-  QString target_url = INOREADER_API_FEED_CONTENTS;
+QList<Message> InoreaderNetworkFactory::messages(const QString& stream_id, qint64 newer_than, int limit,
+                                                qint64& newest_timestamp, Feed::Status& error) {
   QString bearer = m_oauth2->bearer().toLocal8Bit();
 
   if (bearer.isEmpty()) {
@@ -118,28 +116,51 @@ QList<Message> InoreaderNetworkFactory::messages(const QString& stream_id, Feed:
     return QList<Message>();
   }
 
-  target_url += QSL("/") + QUrl::toPercentEncoding(stream_id) + QString("?n=%1").arg(batchSize());
-  downloader.appendRawHeader(QString(HTTP_HEADERS_AUTHORIZATION).toLocal8Bit(), bearer.toLocal8Bit());
+  QList<Message> messages;
+  QString continuation;
 
-  // We need to quit event loop when the download finishes.
-  connect(&downloader, &Downloader::completed, &loop, &QEventLoop::quit);
-  downloader.downloadFile(target_url, qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt());
-  loop.exec();
+  newest_timestamp = newer_than;
+
+  do {
+    Downloader downloader;
+    QEventLoop loop;
+    const int page_size = limit > 0 ? qMin(limit - messages.size(), INOREADER_MAX_STREAM_ITEMS) : INOREADER_MAX_STREAM_ITEMS;
+    QString target_url = INOREADER_API_FEED_CONTENTS;
+
+    target_url += QSL("/") + QUrl::toPercentEncoding(stream_id) + QString("?n=%1").arg(page_size);
+
+    if (newer_than > 0) {
+      target_url += QString("&ot=%1").arg(newer_than);
+    }
+
+    if (!continuation.isEmpty()) {
+      target_url += QSL("&c=") + QUrl::toPercentEncoding(continuation);
+    }
+
+    downloader.appendRawHeader(QString(HTTP_HEADERS_AUTHORIZATION).toLocal8Bit(), bearer.toLocal8Bit());
+
+    // We need to quit event loop when the download finishes.
+    connect(&downloader, &Downloader::completed, &loop, &QEventLoop::quit);
+    downloader.downloadFile(target_url, qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt());
+    loop.exec();
+
+    if (downloader.lastOutputError() != QNetworkReply::NetworkError::NoError) {
+      qCritical("Cannot download messages for '%s', network error: %d.", qPrintable(stream_id), int(downloader.lastOutputError()));
+      error = Feed::Status::NetworkError;
+      return QList<Message>();
+    }
 
-  if (downloader.lastOutputError() != QNetworkReply::NetworkError::NoError) {
-    qCritical("Cannot download messages for '%s', network error: %d.", qPrintable(stream_id), int(downloader.lastOutputError()));
-    error = Feed::Status::NetworkError;
-    return QList<Message>();
-  }
-  else {
     QString messages_data = downloader.lastOutputData();
 
-    error = Feed::Status::Normal;
-    return decodeMessages(messages_data, stream_id);
-  }
+    messages.append(decodeMessages(messages_data, stream_id, continuation, newest_timestamp));
+  } while (!continuation.isEmpty() && (limit <= 0 || messages.size() < limit));
+
+  error = Feed::Status::Normal;
+  return messages;
 }
 
-void InoreaderNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async) {
+QNetworkReply::NetworkError InoreaderNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids,
+                                                                      bool async) {
   QString target_url = INOREADER_API_EDIT_TAG;
 
   if (status == RootItem::ReadStatus::Read) {
@@ -152,7 +173,7 @@ void InoreaderNetworkFactory::markMessagesRead(RootItem::ReadStatus status, cons
   QString bearer = m_oauth2->bearer().toLocal8Bit();
 
   if (bearer.isEmpty()) {
-    return;
+    return QNetworkReply::AuthenticationRequiredError;
   }
 
   QList<QPair<QByteArray, QByteArray>> headers;
@@ -194,21 +215,27 @@ void InoreaderNetworkFactory::markMessagesRead(RootItem::ReadStatus status, cons
     }
     else {
       QByteArray output;
-
-      NetworkFactory::performNetworkOperation(batch_final_url,
-                                              timeout,
-                                              QByteArray(),
-                                              output,
-                                              QNetworkAccessManager::Operation::GetOperation,
-                                              headers);
+      NetworkResult network_reply = NetworkFactory::performNetworkOperation(batch_final_url,
+                                                                            timeout,
+                                                                            QByteArray(),
+                                                                            output,
+                                                                            QNetworkAccessManager::Operation::GetOperation,
+                                                                            headers);
+
+      if (network_reply.first != QNetworkReply::NoError) {
+        return network_reply.first;
+      }
     }
 
     // Cleanup for next batch.
     working_subset.clear();
   }
+
+  return QNetworkReply::NoError;
 }
 
-void InoreaderNetworkFactory::markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids, bool async) {
+QNetworkReply::NetworkError InoreaderNetworkFactory::markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids,
+                                                                         bool async) {
   QString target_url = INOREADER_API_EDIT_TAG;
 
   if (importance == RootItem::Importance::Important) {
@@ -221,7 +248,7 @@ void InoreaderNetworkFactory::markMessagesStarred(RootItem::Importance importanc
   QString bearer = m_oauth2->bearer().toLocal8Bit();
 
   if (bearer.isEmpty()) {
-    return;
+    return QNetworkReply::AuthenticationRequiredError;
   }
 
   QList<QPair<QByteArray, QByteArray>> headers;
@@ -263,18 +290,23 @@ void InoreaderNetworkFactory::markMessagesStarred(RootItem::Importance importanc
     }
     else {
       QByteArray output;
-
-      NetworkFactory::performNetworkOperation(batch_final_url,
-                                              timeout,
-                                              QByteArray(),
-                                              output,
-                                              QNetworkAccessManager::Operation::GetOperation,
-                                              headers);
+      NetworkResult network_reply = NetworkFactory::performNetworkOperation(batch_final_url,
+                                                                            timeout,
+                                                                            QByteArray(),
+                                                                            output,
+                                                                            QNetworkAccessManager::Operation::GetOperation,
+                                                                            headers);
+
+      if (network_reply.first != QNetworkReply::NoError) {
+        return network_reply.first;
+      }
     }
 
     // Cleanup for next batch.
     working_subset.clear();
   }
+
+  return QNetworkReply::NoError;
 }
 
 void InoreaderNetworkFactory::onTokensError(const QString& error, const QString& error_description) {
@@ -301,9 +333,13 @@ void InoreaderNetworkFactory::onAuthFailed() {
   });
 }
 
-QList<Message> InoreaderNetworkFactory::decodeMessages(const QString& messages_json_data, const QString& stream_id) {
+QList<Message> InoreaderNetworkFactory::decodeMessages(const QString& messages_json_data, const QString& stream_id,
+                                                      QString& continuation, qint64& newest_timestamp) {
   QList<Message> messages;
-  QJsonArray json = QJsonDocument::fromJson(messages_json_data.toUtf8()).object()["items"].toArray();
+  QJsonObject json_stream = QJsonDocument::fromJson(messages_json_data.toUtf8()).object();
+  QJsonArray json = json_stream["items"].toArray();
+
+  continuation = json_stream["continuation"].toString();
 
   messages.reserve(json.count());
 
@@ -353,8 +389,12 @@ QList<Message> InoreaderNetworkFactory::decodeMessages(const QString& messages_j
       }
     }
 
+    // NOTE: Messages of aggregated streams like reading list are assigned to their original feeds.
+    QString origin_stream_id = message_obj["origin"].toObject()["streamId"].toString();
+
     message.m_contents = message_obj["summary"].toObject()["content"].toString();
-    message.m_feedId = stream_id;
+    message.m_feedId = origin_stream_id.isEmpty() ? stream_id : origin_stream_id;
+    newest_timestamp = qMax(newest_timestamp, message_obj["timestampUsec"].toString().toLongLong() / 1000000);
 
     messages.append(message);
   }
@@ -38,16 +38,22 @@ class InoreaderNetworkFactory : public QObject {
     // Returned items do not have primary IDs assigned.
     RootItem* feedsCategories(bool obtain_icons);
 
-    QList<Message> messages(const QString& stream_id, Feed::Status& error);
-    void markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
-    void markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids, bool async = true);
+    // Obtains messages of given stream, continuation is followed until at most "limit"
+    // messages are obtained. If "newer_than" is set, then only messages which arrived
+    // later are obtained. Arrival time of newest obtained message is set to "newest_timestamp".
+    QList<Message> messages(const QString& stream_id, qint64 newer_than, int limit,
+                            qint64& newest_timestamp, Feed::Status& error);
+    QNetworkReply::NetworkError markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
+    QNetworkReply::NetworkError markMessagesStarred(RootItem::Importance importance, const QStringList& custom_ids,
+                                                    bool async = true);
 
   private slots:
     void onTokensError(const QString& error, const QString& error_description);
     void onAuthFailed();
 
   private:
-    QList<Message> decodeMessages(const QString& messages_json_data, const QString& stream_id);
+    QList<Message> decodeMessages(const QString& messages_json_data, const QString& stream_id,
+                                  QString& continuation, qint64& newest_timestamp);
     RootItem* decodeFeedCategoriesData(const QString& categories, const QString& feeds, bool obtain_icons);
 
     void initializeOauth();
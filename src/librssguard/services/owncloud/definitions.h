@@ -9,4 +9,8 @@
 #define OWNCLOUD_MIN_VERSION          "6.0.5"
 #define OWNCLOUD_UNLIMITED_BATCH_SIZE -1
 
+// Types of items queries.
+#define OWNCLOUD_ITEMS_TYPE_FEED      0
+#define OWNCLOUD_ITEMS_TYPE_ALL       3
+
 #endif // OWNCLOUD_DEFINITIONS_H
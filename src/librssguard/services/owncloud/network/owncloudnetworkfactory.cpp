@@ -15,6 +15,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QPixmap>
+#include <QVariant>
 #include <utility>
 
 OwnCloudNetworkFactory::OwnCloudNetworkFactory()
@@ -22,7 +23,7 @@ OwnCloudNetworkFactory::OwnCloudNetworkFactory()
   m_authUsername(QString()), m_authPassword(QString()), m_batchSize(OWNCLOUD_UNLIMITED_BATCH_SIZE), m_urlUser(QString()), m_urlStatus(
     QString()),
   m_urlFolders(QString()), m_urlFeeds(QString()), m_urlMessages(QString()), m_urlFeedsUpdate(QString()),
-  m_urlDeleteFeed(QString()), m_urlRenameFeed(QString()), m_userId(QString()) {}
+  m_urlDeleteFeed(QString()), m_urlRenameFeed(QString()), m_urlUpdatedMessages(QString()), m_userId(QString()) {}
 
 OwnCloudNetworkFactory::~OwnCloudNetworkFactory() = default;
 
@@ -49,6 +50,7 @@ void OwnCloudNetworkFactory::setUrl(const QString& url) {
   m_urlFeedsUpdate = m_fixedUrl + OWNCLOUD_API_PATH + "feeds/update?userId=%1&feedId=%2";
   m_urlDeleteFeed = m_fixedUrl + OWNCLOUD_API_PATH + "feeds/%1";
   m_urlRenameFeed = m_fixedUrl + OWNCLOUD_API_PATH + "feeds/%1/rename";
+  m_urlUpdatedMessages = m_fixedUrl + OWNCLOUD_API_PATH + "items/updated?lastModified=%1&type=%2&id=0";
   setUserId(QString());
 }
 
@@ -257,14 +259,14 @@ bool OwnCloudNetworkFactory::renameFeed(const QString& new_name, const QString&
   }
 }
 
-OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getMessages(int feed_id) {
-  if (forceServerSideUpdate()) {
+OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getMessages(int feed_id, int type, int feeds_count) {
+  if (forceServerSideUpdate() && type == OWNCLOUD_ITEMS_TYPE_FEED) {
     triggerFeedUpdate(feed_id);
   }
 
   QString final_url = m_urlMessages.arg(QString::number(feed_id),
-                                        QString::number(batchSize() <= 0 ? -1 : batchSize()),
-                                        QString::number(0),
+                                        QString::number(batchSize() <= 0 ? -1 : batchSize() * qMax(1, feeds_count)),
+                                        QString::number(type),
                                         m_downloadOnlyUnreadMessages ? QSL("false") : QSL("true"));
   QByteArray result_raw;
   QList<QPair<QByteArray, QByteArray>> headers;
@@ -288,6 +290,30 @@ OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getMessages(int feed_id) {
   return msgs_response;
 }
 
+OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getUpdatedMessages(qint64 last_modified) {
+  QString final_url = m_urlUpdatedMessages.arg(QString::number(last_modified), QString::number(OWNCLOUD_ITEMS_TYPE_ALL));
+  QByteArray result_raw;
+  QList<QPair<QByteArray, QByteArray>> headers;
+
+  headers << QPair<QByteArray, QByteArray>(HTTP_HEADERS_CONTENT_TYPE, OWNCLOUD_CONTENT_TYPE_JSON);
+  headers << NetworkFactory::generateBasicAuthHeader(m_authUsername, m_authPassword);
+
+  NetworkResult network_reply = NetworkFactory::performNetworkOperation(final_url,
+                                                                        qApp->settings()->value(GROUP(Feeds),
+                                                                                                SETTING(Feeds::UpdateTimeout)).toInt(),
+                                                                        QByteArray(), result_raw,
+                                                                        QNetworkAccessManager::GetOperation,
+                                                                        headers);
+  OwnCloudGetMessagesResponse msgs_response(QString::fromUtf8(result_raw));
+
+  if (network_reply.first != QNetworkReply::NoError) {
+    qWarning("Nextcloud: Obtaining updated messages failed with error %d.", network_reply.first);
+  }
+
+  m_lastError = network_reply.first;
+  return msgs_response;
+}
+
 QNetworkReply::NetworkError OwnCloudNetworkFactory::triggerFeedUpdate(int feed_id) {
   if (userId().isEmpty()) {
     // We need to get user ID first.
@@ -324,7 +350,8 @@ QNetworkReply::NetworkError OwnCloudNetworkFactory::triggerFeedUpdate(int feed_i
   return (m_lastError = network_reply.first);
 }
 
-void OwnCloudNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async) {
+QNetworkReply::NetworkError OwnCloudNetworkFactory::markMessagesRead(RootItem::ReadStatus status,
+                                                                 const QStringList& custom_ids, bool async) {
   QJsonObject json;
   QJsonArray ids;
   QString final_url;
@@ -354,23 +381,25 @@ void OwnCloudNetworkFactory::markMessagesRead(RootItem::ReadStatus status, const
                                                  QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                  QNetworkAccessManager::PutOperation,
                                                  headers);
+
+    return QNetworkReply::NoError;
   }
   else {
     QByteArray output;
 
-    NetworkFactory::performNetworkOperation(final_url,
-                                            qApp->settings()->value(GROUP(Feeds),
-                                                                    SETTING(Feeds::UpdateTimeout)).toInt(),
-                                            QJsonDocument(json).toJson(QJsonDocument::Compact),
-                                            output,
-                                            QNetworkAccessManager::PutOperation,
-                                            headers);
+    return NetworkFactory::performNetworkOperation(final_url,
+                                                   qApp->settings()->value(GROUP(Feeds),
+                                                                           SETTING(Feeds::UpdateTimeout)).toInt(),
+                                                   QJsonDocument(json).toJson(QJsonDocument::Compact),
+                                                   output,
+                                                   QNetworkAccessManager::PutOperation,
+                                                   headers).first;
   }
 }
 
-void OwnCloudNetworkFactory::markMessagesStarred(RootItem::Importance importance,
-                                                 const QStringList& feed_ids,
-                                                 const QStringList& guid_hashes, bool async) {
+QNetworkReply::NetworkError OwnCloudNetworkFactory::markMessagesStarred(RootItem::Importance importance,
+                                                                    const QStringList& feed_ids,
+                                                                    const QStringList& guid_hashes, bool async) {
   QJsonObject json;
   QJsonArray ids;
   QString final_url;
@@ -404,17 +433,19 @@ void OwnCloudNetworkFactory::markMessagesStarred(RootItem::Importance importance
                                                  QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                  QNetworkAccessManager::PutOperation,
                                                  headers);
+
+    return QNetworkReply::NoError;
   }
   else {
     QByteArray output;
 
-    NetworkFactory::performNetworkOperation(final_url,
-                                            qApp->settings()->value(GROUP(Feeds),
-                                                                    SETTING(Feeds::UpdateTimeout)).toInt(),
-                                            QJsonDocument(json).toJson(QJsonDocument::Compact),
-                                            output,
-                                            QNetworkAccessManager::PutOperation,
-                                            headers);
+    return NetworkFactory::performNetworkOperation(final_url,
+                                                   qApp->settings()->value(GROUP(Feeds),
+                                                                           SETTING(Feeds::UpdateTimeout)).toInt(),
+                                                   QJsonDocument(json).toJson(QJsonDocument::Compact),
+                                                   output,
+                                                   QNetworkAccessManager::PutOperation,
+                                                   headers).first;
   }
 }
 
@@ -640,3 +671,14 @@ QList<Message>OwnCloudGetMessagesResponse::messages() const {
 
   return msgs;
 }
+
+qint64 OwnCloudGetMessagesResponse::lastModified() const {
+  qint64 last_modified = 0;
+
+  for (const QJsonValue& message : m_rawContent["items"].toArray()) {
+    // NOTE: Some versions of News app send this value as string.
+    last_modified = qMax(last_modified, message.toObject()["lastModified"].toVariant().toLongLong());
+  }
+
+  return last_modified;
+}
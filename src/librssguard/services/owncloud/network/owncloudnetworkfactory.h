@@ -5,6 +5,7 @@
 
 #include "core/message.h"
 #include "services/abstract/rootitem.h"
+#include "services/owncloud/definitions.h"
 
 #include <QDateTime>
 #include <QIcon>
@@ -42,6 +43,9 @@ class OwnCloudGetMessagesResponse : public OwnCloudResponse {
     virtual ~OwnCloudGetMessagesResponse();
 
     QList<Message> messages() const;
+
+    // Returns last modification time of the most recently modified message.
+    qint64 lastModified() const;
 };
 
 class OwnCloudStatusResponse : public OwnCloudResponse {
@@ -108,14 +112,18 @@ class OwnCloudNetworkFactory {
     bool createFeed(const QString& url, int parent_id);
     bool renameFeed(const QString& new_name, const QString& custom_feed_id);
 
-    // Get messages for given feed.
-    OwnCloudGetMessagesResponse getMessages(int feed_id);
+    // Get messages for given feed, or for whole account if "type" is OWNCLOUD_ITEMS_TYPE_ALL.
+    // Batch size is multiplied by "feeds_count" when messages of more feeds are obtained.
+    OwnCloudGetMessagesResponse getMessages(int feed_id, int type = OWNCLOUD_ITEMS_TYPE_FEED, int feeds_count = 1);
+
+    // Get messages of whole account, which were changed after given time.
+    OwnCloudGetMessagesResponse getUpdatedMessages(qint64 last_modified);
 
     // Misc methods.
     QNetworkReply::NetworkError triggerFeedUpdate(int feed_id);
-    void markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
-    void markMessagesStarred(RootItem::Importance importance, const QStringList& feed_ids,
-                             const QStringList& guid_hashes, bool async = true);
+    QNetworkReply::NetworkError markMessagesRead(RootItem::ReadStatus status, const QStringList& custom_ids, bool async = true);
+    QNetworkReply::NetworkError markMessagesStarred(RootItem::Importance importance, const QStringList& feed_ids,
+                                                    const QStringList& guid_hashes, bool async = true);
 
     // Gets/sets the amount of messages to obtain during single feed update.
     int batchSize() const;
@@ -144,6 +152,7 @@ class OwnCloudNetworkFactory {
     QString m_urlFeedsUpdate;
     QString m_urlDeleteFeed;
     QString m_urlRenameFeed;
+    QString m_urlUpdatedMessages;
     QString m_userId;
 };
 
@@ -68,16 +68,23 @@ OwnCloudServiceRoot* OwnCloudFeed::serviceRoot() const {
 }
 
 QList<Message> OwnCloudFeed::obtainNewMessages(bool* error_during_obtaining) {
-  OwnCloudGetMessagesResponse messages = serviceRoot()->network()->getMessages(customNumericId());
+  Feed::Status error = Feed::Status::Normal;
+  QList<Message> messages = serviceRoot()->takeSyncedMessages(customId(), error);
 
-  if (serviceRoot()->network()->lastError() != QNetworkReply::NoError) {
-    setStatus(Feed::NetworkError);
+  if (error != Feed::Status::Normal) {
     *error_during_obtaining = true;
+    setStatus(Feed::NetworkError);
     serviceRoot()->itemChanged(QList<RootItem*>() << this);
     return QList<Message>();
   }
   else {
     *error_during_obtaining = false;
-    return messages.messages();
+    return messages;
   }
 }
+
+void OwnCloudFeed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  Q_UNUSED(counts_delta)
+
+  serviceRoot()->onAfterSyncedMessagesStored(db, customId());
+}
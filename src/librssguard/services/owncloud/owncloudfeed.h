@@ -25,6 +25,9 @@ class OwnCloudFeed : public Feed {
 
     OwnCloudServiceRoot* serviceRoot() const;
     QList<Message> obtainNewMessages(bool* error_during_obtaining);
+
+  protected:
+    void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
 };
 
 #endif // OWNCLOUDFEED_H
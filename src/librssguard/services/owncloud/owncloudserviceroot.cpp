@@ -91,40 +91,21 @@ OwnCloudNetworkFactory* OwnCloudServiceRoot::network() const {
   return m_network;
 }
 
-void OwnCloudServiceRoot::saveAllCachedData(bool async) {
-  QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> msgCache = takeMessageCache();
-  QMapIterator<RootItem::ReadStatus, QStringList> i(msgCache.first);
-
-  // Save the actual data read/unread.
-  while (i.hasNext()) {
-    i.next();
-    auto key = i.key();
-    QStringList ids = i.value();
-
-    if (!ids.isEmpty()) {
-      network()->markMessagesRead(key, ids, async);
-    }
-  }
-
-  QMapIterator<RootItem::Importance, QList<Message>> j(msgCache.second);
-
-  // Save the actual data important/not important.
-  while (j.hasNext()) {
-    j.next();
-    auto key = j.key();
-    QList<Message> messages = j.value();
-
-    if (!messages.isEmpty()) {
-      QStringList feed_ids, guid_hashes;
+QNetworkReply::NetworkError OwnCloudServiceRoot::sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids,
+                                                                       bool async) {
+  return network()->markMessagesRead(read, custom_ids, async);
+}
 
-      for (const Message& msg : messages) {
-        feed_ids.append(msg.m_feedId);
-        guid_hashes.append(msg.m_customHash);
-      }
+QNetworkReply::NetworkError OwnCloudServiceRoot::sendMessageImportances(RootItem::Importance importance,
+                                                                        const QList<Message>& messages, bool async) {
+  QStringList feed_ids, guid_hashes;
 
-      network()->markMessagesStarred(key, feed_ids, guid_hashes, async);
-    }
+  for (const Message& msg : messages) {
+    feed_ids.append(msg.m_feedId);
+    guid_hashes.append(msg.m_customHash);
   }
+
+  return network()->markMessagesStarred(importance, feed_ids, guid_hashes, async);
 }
 
 void OwnCloudServiceRoot::updateTitle() {
@@ -139,6 +120,8 @@ void OwnCloudServiceRoot::saveAccountDataToDatabase() {
                                                   m_network->authPassword(), m_network->url(),
                                                   m_network->forceServerSideUpdate(), m_network->batchSize(),
                                                   m_network->downloadOnlyUnreadMessages(), accountId())) {
+      // Account settings might be changed, so all messages are downloaded again.
+      setSyncCursor(0);
       updateTitle();
       itemChanged(QList<RootItem*>() << this);
     }
@@ -161,6 +144,48 @@ void OwnCloudServiceRoot::saveAccountDataToDatabase() {
   }
 }
 
+Feed::Status OwnCloudServiceRoot::downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                                        QList<Message>& messages, qint64& new_cursor) {
+  if (m_network->forceServerSideUpdate()) {
+    // Server must update feeds before messages of whole account are downloaded.
+    for (const QString& feed_custom_id : feed_custom_ids) {
+      m_network->triggerFeedUpdate(feed_custom_id.toInt());
+    }
+  }
+
+  // First download respects batch size of each feed, next ones obtain only changed messages.
+  const bool initial_sync = cursor <= 0;
+  OwnCloudGetMessagesResponse response = initial_sync
+                                         ? m_network->getMessages(0, OWNCLOUD_ITEMS_TYPE_ALL, feed_custom_ids.size())
+                                         : m_network->getUpdatedMessages(cursor);
+
+  if (m_network->lastError() != QNetworkReply::NoError) {
+    return Feed::Status::NetworkError;
+  }
+
+  messages = response.messages();
+  new_cursor = response.lastModified();
+
+  qDebug("Nextcloud: Obtained %d messages of account %d using %s synchronization.",
+         messages.size(), accountId(), initial_sync ? "full" : "incremental");
+  return Feed::Status::Normal;
+}
+
+Feed::Status OwnCloudServiceRoot::downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages) {
+  OwnCloudGetMessagesResponse response = m_network->getMessages(feed_custom_id.toInt());
+
+  if (m_network->lastError() != QNetworkReply::NoError) {
+    return Feed::Status::NetworkError;
+  }
+
+  messages = response.messages();
+  return Feed::Status::Normal;
+}
+
+bool OwnCloudServiceRoot::storeSyncCursor(const QSqlDatabase& db, qint64 cursor) {
+  return DatabaseQueries::storeOwnCloudLastModified(db, cursor, accountId());
+}
+
 void OwnCloudServiceRoot::addNewFeed(const QString& url) {
   if (!qApp->feedUpdateLock()->tryLock()) {
     // Lock was not obtained because
@@ -5,13 +5,14 @@
 
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/serviceroot.h"
+#include "services/abstract/syncforserviceroot.h"
 
 #include <QMap>
 
 class OwnCloudNetworkFactory;
 class Mutex;
 
-class OwnCloudServiceRoot : public ServiceRoot, public CacheForServiceRoot {
+class OwnCloudServiceRoot : public ServiceRoot, public CacheForServiceRoot, public SyncForServiceRoot {
   Q_OBJECT
 
   public:
@@ -34,12 +35,21 @@ class OwnCloudServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     void updateTitle();
     void saveAccountDataToDatabase();
 
-    void saveAllCachedData(bool async = true);
-
   public slots:
     void addNewFeed(const QString& url);
     void addNewCategory();
 
+  protected:
+    QNetworkReply::NetworkError sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids, bool async);
+    QNetworkReply::NetworkError sendMessageImportances(RootItem::Importance importance, const QList<Message>& messages,
+                                                       bool async);
+
+    // Cursor is modification time of newest downloaded message.
+    Feed::Status downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                        QList<Message>& messages, qint64& new_cursor);
+    Feed::Status downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages);
+    bool storeSyncCursor(const QSqlDatabase& db, qint64 cursor);
+
   private:
     RootItem* obtainNewTreeForSyncIn() const;
 
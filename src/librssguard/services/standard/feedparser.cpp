@@ -2,10 +2,10 @@
 
 #include "services/standard/feedparser.h"
 
+#include "core/messagesanitizer.h"
 #include "exceptions/applicationexception.h"
 
 #include <QDebug>
-#include <QRegularExpression>
 #include <utility>
 
 FeedParser::FeedParser(QString data) : m_xmlData(std::move(data)), m_mrssNamespace(QSL("http://search.yahoo.com/mrss/")) {
@@ -33,7 +33,7 @@ QList<Message> FeedParser::messages() {
         new_message.m_author = feed_author;
       }
 
-      new_message.m_url = new_message.m_url.replace(QRegularExpression("[\\t\\n]"), QString());
+      new_message.m_url = MessageSanitizer::sanitizeUrl(new_message.m_url);
 
       messages.append(new_message);
     }
@@ -0,0 +1,484 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "services/standard/feedstreamparser.h"
+
+#include "core/messagesanitizer.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/textfactory.h"
+#include "network-web/webfactory.h"
+
+FeedStreamParser::FeedStreamParser(const QString& data)
+  : m_xml(data), m_atomNamespace(QSL("http://www.w3.org/2005/Atom")), m_mrssNamespace(QSL("http://search.yahoo.com/mrss/")) {}
+
+QList<Message> FeedStreamParser::rssMessages(bool* ok) {
+  QList<Message> messages;
+  const QDateTime current_time = QDateTime::currentDateTime();
+  bool channel_found = false;
+  bool in_channel = false;
+  int depth = 0;
+
+  while (!m_xml.atEnd()) {
+    m_xml.readNext();
+
+    if (m_xml.isStartElement()) {
+      if (depth == 0 && m_xml.qualifiedName() != QL1S("rss")) {
+        // This is not RSS feed.
+        break;
+      }
+      else if (depth == 1 && !channel_found && m_xml.qualifiedName() == QL1S("channel")) {
+        channel_found = in_channel = true;
+      }
+      else if (in_channel && m_xml.qualifiedName() == QL1S("item")) {
+        Message new_message;
+
+        // Whole item including its end tag is consumed here.
+        if (readRssItem(new_message, current_time)) {
+          new_message.m_url = MessageSanitizer::sanitizeUrl(new_message.m_url);
+          messages.append(new_message);
+        }
+
+        continue;
+      }
+
+      depth++;
+    }
+    else if (m_xml.isEndElement()) {
+      if (--depth == 1) {
+        in_channel = false;
+      }
+    }
+  }
+
+  finish(ok);
+  return messages;
+}
+
+QList<Message> FeedStreamParser::rdfMessages(bool* ok) {
+  QList<Message> messages;
+  const QDateTime current_time = QDateTime::currentDateTime();
+
+  while (!m_xml.atEnd()) {
+    m_xml.readNext();
+
+    if (m_xml.isStartElement() && m_xml.qualifiedName() == QL1S("item")) {
+      Message new_message;
+
+      if (readRdfItem(new_message, current_time)) {
+        messages.append(new_message);
+      }
+    }
+  }
+
+  finish(ok);
+  return messages;
+}
+
+QList<Message> FeedStreamParser::atomMessages(bool* ok) {
+  QList<Message> messages;
+  QStringList feed_authors;
+  const QDateTime current_time = QDateTime::currentDateTime();
+  bool root_found = false;
+  bool author_pending = false;
+
+  while (!m_xml.atEnd()) {
+    m_xml.readNext();
+
+    if (m_xml.isStartElement()) {
+      if (!root_found) {
+        root_found = true;
+
+        if (m_xml.attributes().value(QL1S("version")) == QL1S("0.3")) {
+          m_atomNamespace = QSL("http://purl.org/atom/ns#");
+        }
+      }
+
+      if (m_xml.namespaceUri() != m_atomNamespace) {
+        continue;
+      }
+
+      if (m_xml.name() == QL1S("entry")) {
+        Message new_message;
+
+        if (readAtomEntry(new_message, feed_authors, current_time)) {
+          messages.append(new_message);
+        }
+      }
+      else if (m_xml.name() == QL1S("author")) {
+        author_pending = true;
+      }
+      else if (author_pending && m_xml.name() == QL1S("name")) {
+        const QString name = readText();
+
+        author_pending = false;
+
+        if (!name.isEmpty() && !feed_authors.contains(name)) {
+          feed_authors.append(name);
+        }
+      }
+    }
+    else if (m_xml.isEndElement() && m_xml.namespaceUri() == m_atomNamespace && m_xml.name() == QL1S("author")) {
+      author_pending = false;
+    }
+  }
+
+  // Authors of feed are known only after whole document is read.
+  const QString feed_author = feed_authors.join(QSL(", "));
+
+  for (Message& message : messages) {
+    if (message.m_author.isEmpty()) {
+      message.m_author = feed_author;
+    }
+
+    message.m_url = MessageSanitizer::sanitizeUrl(message.m_url);
+  }
+
+  finish(ok);
+  return messages;
+}
+
+void FeedStreamParser::readItem(const QStringList& child_names, QHash<QString, QString>& texts,
+                                QHash<QString, QXmlStreamAttributes>& attributes, QList<Enclosure>& mrss_enclosures) {
+  QList<Enclosure> mrss_thumbnails;
+  int depth = 0;
+
+  while (!m_xml.atEnd()) {
+    m_xml.readNext();
+
+    if (m_xml.isStartElement()) {
+      if (m_xml.namespaceUri() == m_mrssNamespace) {
+        addMrssEnclosure(mrss_enclosures, mrss_thumbnails);
+      }
+
+      const QString name = m_xml.qualifiedName().toString();
+
+      if (depth == 0 && child_names.contains(name) && !texts.contains(name)) {
+        attributes.insert(name, m_xml.attributes());
+        texts.insert(name, readText());
+        continue;
+      }
+
+      depth++;
+    }
+    else if (m_xml.isEndElement() && depth-- == 0) {
+      break;
+    }
+  }
+
+  mrss_enclosures.append(mrss_thumbnails);
+}
+
+bool FeedStreamParser::readRssItem(Message& message, const QDateTime& current_time) {
+  static const QStringList child_names = {
+    QSL("title"), QSL("encoded"), QSL("description"), QSL("enclosure"), QSL("link"),
+    QSL("author"), QSL("creator"), QSL("pubDate"), QSL("date")
+  };
+  QHash<QString, QString> texts;
+  QHash<QString, QXmlStreamAttributes> attributes;
+  QList<Enclosure> mrss_enclosures;
+
+  readItem(child_names, texts, attributes, mrss_enclosures);
+
+  // Deal with titles & descriptions.
+  const QXmlStreamAttributes enclosure_attributes = attributes.value(QSL("enclosure"));
+  const QString elem_title = texts.value(QSL("title")).simplified();
+  const QString elem_enclosure = enclosure_attributes.value(QL1S("url")).toString();
+  const QString elem_enclosure_type = enclosure_attributes.value(QL1S("type")).toString();
+  QString elem_description = texts.value(QSL("encoded"));
+
+  if (elem_description.isEmpty()) {
+    elem_description = texts.value(QSL("description"));
+  }
+
+  // Now we obtained maximum of information for title & description.
+  if (elem_title.isEmpty()) {
+    if (elem_description.isEmpty()) {
+      // BOTH title and description are empty, skip this message.
+      return false;
+    }
+    else {
+      // Title is empty but description is not.
+      message.m_title = MessageSanitizer::stripTags(elem_description.simplified());
+      message.m_contents = elem_description;
+    }
+  }
+  else {
+    // Title is really not empty, description does not matter.
+    message.m_title = MessageSanitizer::stripTags(elem_title);
+    message.m_contents = elem_description;
+  }
+
+  if (!elem_enclosure.isEmpty()) {
+    message.m_enclosures.append(Enclosure(elem_enclosure, elem_enclosure_type));
+    qDebug("Found enclosure '%s' for the message.", qPrintable(elem_enclosure));
+  }
+  else {
+    message.m_enclosures.append(mrss_enclosures);
+  }
+
+  // Deal with link and author.
+  message.m_url = texts.value(QSL("link"));
+
+  if (message.m_url.isEmpty() && !message.m_enclosures.isEmpty()) {
+    message.m_url = message.m_enclosures.first().m_url;
+  }
+
+  if (message.m_url.isEmpty()) {
+    // Try to get "href" attribute.
+    message.m_url = attributes.value(QSL("link")).value(QL1S("href")).toString();
+  }
+
+  message.m_author = texts.value(QSL("author"));
+
+  if (message.m_author.isEmpty()) {
+    message.m_author = texts.value(QSL("creator"));
+  }
+
+  // Deal with creation date.
+  message.m_created = TextFactory::parseDateTime(texts.value(QSL("pubDate")));
+
+  if (message.m_created.isNull()) {
+    message.m_created = TextFactory::parseDateTime(texts.value(QSL("date")));
+  }
+
+  if (!(message.m_createdFromFeed = !message.m_created.isNull())) {
+    // Date was NOT obtained from the feed,
+    // set current date as creation date for the message.
+    message.m_created = current_time;
+  }
+
+  if (message.m_author.isNull()) {
+    message.m_author = "";
+  }
+
+  if (message.m_url.isNull()) {
+    message.m_url = "";
+  }
+
+  return true;
+}
+
+bool FeedStreamParser::readRdfItem(Message& message, const QDateTime& current_time) {
+  static const QStringList child_names = {
+    QSL("title"), QSL("description"), QSL("link"), QSL("creator"), QSL("date"), QSL("dc:date")
+  };
+  QHash<QString, QString> texts;
+  QHash<QString, QXmlStreamAttributes> attributes;
+  QList<Enclosure> mrss_enclosures;
+
+  readItem(child_names, texts, attributes, mrss_enclosures);
+
+  // Deal with title and description.
+  const QString elem_title = texts.value(QSL("title")).simplified();
+  const QString elem_description = texts.value(QSL("description"));
+
+  // Now we obtained maximum of information for title & description.
+  if (elem_title.isEmpty()) {
+    if (elem_description.isEmpty()) {
+      // BOTH title and description are empty, skip this message.
+      return false;
+    }
+    else {
+      // Title is empty but description is not.
+      message.m_title = qApp->web()->escapeHtml(MessageSanitizer::stripTags(elem_description.simplified()));
+      message.m_contents = elem_description;
+    }
+  }
+  else {
+    // Title is really not empty, description does not matter.
+    message.m_title = qApp->web()->escapeHtml(MessageSanitizer::stripTags(elem_title));
+    message.m_contents = elem_description;
+  }
+
+  // Deal with link and author.
+  message.m_url = texts.value(QSL("link"));
+  message.m_author = texts.value(QSL("creator"));
+
+  // Deal with creation date.
+  QString elem_updated = texts.value(QSL("date"));
+
+  if (elem_updated.isEmpty()) {
+    elem_updated = texts.value(QSL("dc:date"));
+  }
+
+  message.m_created = TextFactory::parseDateTime(elem_updated);
+  message.m_createdFromFeed = !message.m_created.isNull();
+
+  if (!message.m_createdFromFeed) {
+    // Date was NOT obtained from the feed, set current date as creation date for the message.
+    message.m_created = current_time;
+  }
+
+  if (message.m_author.isNull()) {
+    message.m_author = "";
+  }
+
+  if (message.m_url.isNull()) {
+    message.m_url = "";
+  }
+
+  return true;
+}
+
+bool FeedStreamParser::readAtomEntry(Message& message, QStringList& feed_authors, const QDateTime& current_time) {
+  static const QStringList text_names = {
+    QSL("title"), QSL("content"), QSL("summary"), QSL("updated"), QSL("modified")
+  };
+  QHash<QString, QString> texts;
+  QStringList authors;
+  QString media_description;
+  QString last_link_alternate, last_link_other;
+  QList<Enclosure> link_enclosures, mrss_enclosures, mrss_thumbnails;
+  bool media_description_found = false;
+  bool author_pending = false;
+  int depth = 0;
+
+  // NOTE: Values are taken from first matching descendant
+  // of the entry, not only from its direct children.
+  while (!m_xml.atEnd()) {
+    m_xml.readNext();
+
+    if (m_xml.isStartElement()) {
+      const QString name = m_xml.name().toString();
+
+      if (m_xml.namespaceUri() == m_atomNamespace) {
+        if (text_names.contains(name) && !texts.contains(name)) {
+          texts.insert(name, readText());
+          continue;
+        }
+        else if (name == QL1S("author")) {
+          author_pending = true;
+        }
+        else if (author_pending && name == QL1S("name")) {
+          const QString author = readText();
+
+          author_pending = false;
+          authors.append(author);
+
+          if (!author.isEmpty() && !feed_authors.contains(author)) {
+            feed_authors.append(author);
+          }
+
+          continue;
+        }
+        else if (name == QL1S("link")) {
+          const QXmlStreamAttributes link = m_xml.attributes();
+          const QString attribute = link.value(QL1S("rel")).toString();
+
+          if (attribute == QSL("enclosure")) {
+            link_enclosures.append(Enclosure(link.value(QL1S("href")).toString(), link.value(QL1S("type")).toString()));
+            qDebug("Found enclosure '%s' for the message.", qPrintable(link_enclosures.last().m_url));
+          }
+          else if (attribute.isEmpty() || attribute == QSL("alternate")) {
+            last_link_alternate = link.value(QL1S("href")).toString();
+          }
+          else {
+            last_link_other = link.value(QL1S("href")).toString();
+          }
+        }
+      }
+      else if (m_xml.namespaceUri() == m_mrssNamespace) {
+        if (!media_description_found && name == QL1S("description")) {
+          media_description_found = true;
+          media_description = readText();
+          continue;
+        }
+
+        addMrssEnclosure(mrss_enclosures, mrss_thumbnails);
+      }
+
+      depth++;
+    }
+    else if (m_xml.isEndElement()) {
+      if (depth-- == 0) {
+        break;
+      }
+      else if (m_xml.namespaceUri() == m_atomNamespace && m_xml.name() == QL1S("author")) {
+        author_pending = false;
+      }
+    }
+  }
+
+  const QString title = texts.value(QSL("title"));
+  QString summary = texts.value(QSL("content"));
+
+  if (summary.isEmpty()) {
+    summary = texts.value(QSL("summary"));
+
+    if (summary.isEmpty()) {
+      summary = media_description;
+    }
+  }
+
+  // Now we obtained maximum of information for title & description.
+  if (title.isEmpty() && summary.isEmpty()) {
+    // BOTH title and description are empty, skip this message.
+    return false;
+  }
+
+  // Title is not empty, description does not matter.
+  message.m_title = MessageSanitizer::stripTags(title);
+  message.m_contents = summary;
+  message.m_author = qApp->web()->escapeHtml(authors.join(QSL(", ")));
+
+  QString updated = texts.value(QSL("updated"));
+
+  if (updated.isEmpty()) {
+    updated = texts.value(QSL("modified"));
+  }
+
+  // Deal with creation date.
+  message.m_created = TextFactory::parseDateTime(updated);
+  message.m_createdFromFeed = !message.m_created.isNull();
+
+  if (!message.m_createdFromFeed) {
+    // Date was NOT obtained from the feed, set current date as creation date for the message.
+    message.m_created = current_time;
+  }
+
+  // Deal with links and enclosures.
+  message.m_enclosures.append(link_enclosures);
+  message.m_enclosures.append(mrss_enclosures);
+  message.m_enclosures.append(mrss_thumbnails);
+
+  if (!last_link_alternate.isEmpty()) {
+    message.m_url = last_link_alternate;
+  }
+  else if (!last_link_other.isEmpty()) {
+    message.m_url = last_link_other;
+  }
+  else if (!message.m_enclosures.isEmpty()) {
+    message.m_url = message.m_enclosures.first().m_url;
+  }
+
+  return true;
+}
+
+void FeedStreamParser::addMrssEnclosure(QList<Enclosure>& contents, QList<Enclosure>& thumbnails) const {
+  const QXmlStreamAttributes attributes = m_xml.attributes();
+  const QString url = attributes.value(QL1S("url")).toString();
+
+  if (m_xml.name() == QL1S("content")) {
+    const QString type = attributes.value(QL1S("type")).toString();
+
+    if (!url.isEmpty() && !type.isEmpty()) {
+      contents.append(Enclosure(url, type));
+    }
+  }
+  else if (m_xml.name() == QL1S("thumbnail") && !url.isEmpty()) {
+    thumbnails.append(Enclosure(url, QSL("image/png")));
+  }
+}
+
+QString FeedStreamParser::readText() {
+  return m_xml.readElementText(QXmlStreamReader::IncludeChildElements);
+}
+
+void FeedStreamParser::finish(bool* ok) {
+  if (m_xml.hasError()) {
+    qWarning("Streaming feed parser failed at line %lld: '%s'.", m_xml.lineNumber(), qPrintable(m_xml.errorString()));
+  }
+
+  if (ok != nullptr) {
+    *ok = !m_xml.hasError();
+  }
+}
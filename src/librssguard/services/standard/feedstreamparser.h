@@ -0,0 +1,46 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef FEEDSTREAMPARSER_H
+#define FEEDSTREAMPARSER_H
+
+#include "core/message.h"
+
+#include <QHash>
+#include <QList>
+#include <QXmlStreamReader>
+
+// Parses RSS, RDF and ATOM feeds in single pass without building DOM tree.
+// Extracted messages are the same as those from RssParser, RdfParser
+// and AtomParser, which are still used as fallback when XML data are malformed.
+class FeedStreamParser {
+  public:
+    explicit FeedStreamParser(const QString& data);
+
+    // NOTE: If "ok" is set to false, then XML data could not be read
+    // completely and caller should use DOM-based parser instead.
+    QList<Message> rssMessages(bool* ok = nullptr);
+    QList<Message> rdfMessages(bool* ok = nullptr);
+    QList<Message> atomMessages(bool* ok = nullptr);
+
+  private:
+    // Reads current element up to its end tag. Texts and attributes of first direct
+    // children with given names are stored, MRSS enclosures are collected from all descendants.
+    // NOTE: Names are qualified, prefixes must match in the same way as with QDomNode::namedItem().
+    void readItem(const QStringList& child_names, QHash<QString, QString>& texts,
+                  QHash<QString, QXmlStreamAttributes>& attributes, QList<Enclosure>& mrss_enclosures);
+
+    bool readRssItem(Message& message, const QDateTime& current_time);
+    bool readRdfItem(Message& message, const QDateTime& current_time);
+    bool readAtomEntry(Message& message, QStringList& feed_authors, const QDateTime& current_time);
+
+    void addMrssEnclosure(QList<Enclosure>& contents, QList<Enclosure>& thumbnails) const;
+    QString readText();
+    void finish(bool* ok);
+
+  private:
+    QXmlStreamReader m_xml;
+    QString m_atomNamespace;
+    QString m_mrssNamespace;
+};
+
+#endif // FEEDSTREAMPARSER_H
@@ -14,6 +14,7 @@
 #include "network-web/networkfactory.h"
 #include "services/abstract/recyclebin.h"
 #include "services/standard/atomparser.h"
+#include "services/standard/feedstreamparser.h"
 #include "services/standard/gui/formstandardfeeddetails.h"
 #include "services/standard/rdfparser.h"
 #include "services/standard/rssparser.h"
@@ -22,6 +23,7 @@
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDomNode>
+#include <QHash>
 #include <QPointer>
 #include <QTextCodec>
 #include <QVariant>
@@ -35,6 +37,9 @@ StandardFeed::StandardFeed(RootItem* parent_item)
   m_networkError = QNetworkReply::NoError;
   m_type = Rss0X;
   m_encoding = QString();
+  m_httpValidatorsChanged = false;
+  m_contentsHash = m_pendingContentsHash = 0;
+  m_lastDataChange = DataChange::Changed;
 }
 
 StandardFeed::StandardFeed(const StandardFeed& other)
@@ -45,6 +50,12 @@ StandardFeed::StandardFeed(const StandardFeed& other)
   m_networkError = other.networkError();
   m_type = other.type();
   m_encoding = other.encoding();
+  m_httpETag = other.m_httpETag;
+  m_httpLastModified = other.m_httpLastModified;
+  m_contentsHash = other.m_contentsHash;
+  m_pendingContentsHash = 0;
+  m_httpValidatorsChanged = false;
+  m_lastDataChange = DataChange::Changed;
 }
 
 StandardFeed::~StandardFeed() {
@@ -352,6 +363,12 @@ bool StandardFeed::editItself(StandardFeed* new_feed_data) {
   original_feed->setAutoUpdateInitialInterval(new_feed_data->autoUpdateInitialInterval());
   original_feed->setType(new_feed_data->type());
 
+  // Feed could now point to different data, so next
+  // update must download it unconditionally.
+  original_feed->m_httpETag.clear();
+  original_feed->m_httpLastModified.clear();
+  original_feed->m_contentsHash = 0;
+
   // Editing is done.
   return true;
 }
@@ -401,14 +418,23 @@ QList<Message> StandardFeed::obtainNewMessages(bool* error_during_obtaining) {
   int download_timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
 
   QList<QPair<QByteArray, QByteArray>> headers;
+  QList<QPair<QByteArray, QByteArray>> response_headers;
+  int http_status_code = 0;
+
   headers << NetworkFactory::generateBasicAuthHeader(username(), password());
 
-  m_networkError = NetworkFactory::performNetworkOperation(url(),
-                                                           download_timeout,
-                                                           QByteArray(),
-                                                           feed_contents,
-                                                           QNetworkAccessManager::GetOperation,
-                                                           headers).first;
+  // Server sends feed data only if they changed since last update.
+  // NOTE: Headers with empty values are not sent at all.
+  headers << QPair<QByteArray, QByteArray>(QByteArrayLiteral("If-None-Match"), m_httpETag.toLatin1());
+  headers << QPair<QByteArray, QByteArray>(QByteArrayLiteral("If-Modified-Since"), m_httpLastModified.toLatin1());
+
+  m_lastDataChange = DataChange::Changed;
+  m_networkError = NetworkFactory::performGetOperation(url(),
+                                                       download_timeout,
+                                                       feed_contents,
+                                                       http_status_code,
+                                                       response_headers,
+                                                       headers).first;
 
   if (m_networkError != QNetworkReply::NoError) {
     qWarning("Error during fetching of new messages for feed '%s' (id %d).", qPrintable(url()), id());
@@ -420,6 +446,37 @@ QList<Message> StandardFeed::obtainNewMessages(bool* error_during_obtaining) {
     *error_during_obtaining = false;
   }
 
+  if (http_status_code == 304) {
+    qDebug("Feed '%s' (id %d) was not modified since its last update.", qPrintable(url()), id());
+    m_lastDataChange = DataChange::NotModified;
+    return QList<Message>();
+  }
+
+  // Server does not have to support validators, but it could
+  // still send exactly the same data as during previous update.
+  m_pendingContentsHash = contentsHash(feed_contents);
+
+  if (m_contentsHash != 0 && m_pendingContentsHash == m_contentsHash) {
+    qDebug("Data of feed '%s' (id %d) are same as during its last update.", qPrintable(url()), id());
+    m_lastDataChange = DataChange::SameContents;
+    return QList<Message>();
+  }
+
+  // New validators are saved only after messages are stored.
+  m_pendingHttpETag.clear();
+  m_pendingHttpLastModified.clear();
+
+  for (const auto& header : response_headers) {
+    if (header.first.toLower() == QByteArrayLiteral("etag")) {
+      m_pendingHttpETag = QString::fromLatin1(header.second);
+    }
+    else if (header.first.toLower() == QByteArrayLiteral("last-modified")) {
+      m_pendingHttpLastModified = QString::fromLatin1(header.second);
+    }
+  }
+
+  m_httpValidatorsChanged = m_pendingHttpETag != m_httpETag || m_pendingHttpLastModified != m_httpLastModified;
+
   // Encode downloaded data for further parsing.
   QTextCodec* codec = QTextCodec::codecForName(encoding().toLocal8Bit());
   QString formatted_feed_contents;
@@ -434,21 +491,40 @@ QList<Message> StandardFeed::obtainNewMessages(bool* error_during_obtaining) {
   }
 
   // Feed data are downloaded and encoded.
-  // Parse data and obtain messages.
+  // Parse data and obtain messages, DOM-based parsers
+  // are used only if streaming parser cannot read the data.
   QList<Message> messages;
+  FeedStreamParser stream_parser(formatted_feed_contents);
+  bool parsed = true;
 
   switch (type()) {
     case StandardFeed::Rss0X:
     case StandardFeed::Rss2X:
-      messages = RssParser(formatted_feed_contents).messages();
+      messages = stream_parser.rssMessages(&parsed);
+
+      if (!parsed) {
+        messages = RssParser(formatted_feed_contents).messages();
+      }
+
       break;
 
     case StandardFeed::Rdf:
-      messages = RdfParser().parseXmlData(formatted_feed_contents);
+      messages = stream_parser.rdfMessages(&parsed);
+
+      if (!parsed) {
+        messages = RdfParser().parseXmlData(formatted_feed_contents);
+      }
+
       break;
 
     case StandardFeed::Atom10:
-      messages = AtomParser(formatted_feed_contents).messages();
+      messages = stream_parser.atomMessages(&parsed);
+
+      if (!parsed) {
+        messages = AtomParser(formatted_feed_contents).messages();
+      }
+
+      break;
 
     default:
       break;
@@ -457,6 +533,42 @@ QList<Message> StandardFeed::obtainNewMessages(bool* error_during_obtaining) {
   return messages;
 }
 
+Feed::DataChange StandardFeed::lastDataChange() const {
+  return m_lastDataChange;
+}
+
+quint64 StandardFeed::contentsHash(const QByteArray& feed_contents) const {
+  // Hash does not need to be cryptographic, two 32bit hashes with
+  // different fixed seeds are combined to make collisions unlikely.
+  // Fixed seeds keep the hash same across application runs.
+  uint hash_low = qHash(feed_contents, 0x9e3779b9U);
+  uint hash_high = qHash(feed_contents, 0x7f4a7c15U);
+
+  // Changed filters could accept messages which were ignored before,
+  // so data must be processed again.
+  for (const QPointer<MessageFilter>& filter : messageFilters()) {
+    if (!filter.isNull()) {
+      hash_low = qHash(filter->script(), hash_low);
+      hash_high = qHash(filter->script(), hash_high);
+    }
+  }
+
+  return (quint64(hash_high) << 32) | hash_low;
+}
+
+void StandardFeed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  Q_UNUSED(counts_delta)
+
+  if ((m_httpValidatorsChanged || m_pendingContentsHash != m_contentsHash) &&
+      DatabaseQueries::storeFeedValidators(db, id(), m_pendingHttpETag, m_pendingHttpLastModified, m_pendingContentsHash)) {
+    m_httpETag = m_pendingHttpETag;
+    m_httpLastModified = m_pendingHttpLastModified;
+    m_httpValidatorsChanged = false;
+  }
+
+  m_contentsHash = m_pendingContentsHash;
+}
+
 QNetworkReply::NetworkError StandardFeed::networkError() const {
   return m_networkError;
 }
@@ -476,4 +588,10 @@ StandardFeed::StandardFeed(const QSqlRecord& record) : Feed(record) {
   setAutoUpdateType(static_cast<Feed::AutoUpdateType>(record.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
   setAutoUpdateInitialInterval(record.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
   m_networkError = QNetworkReply::NoError;
+  m_httpETag = record.value(FDS_DB_HTTP_ETAG_INDEX).toString();
+  m_httpLastModified = record.value(FDS_DB_HTTP_LAST_MODIFIED_INDEX).toString();
+  m_httpValidatorsChanged = false;
+  m_contentsHash = quint64(record.value(FDS_DB_CONTENTS_HASH_INDEX).toLongLong());
+  m_pendingContentsHash = 0;
+  m_lastDataChange = DataChange::Changed;
 }
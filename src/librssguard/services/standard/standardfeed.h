@@ -68,6 +68,7 @@ class StandardFeed : public Feed {
     QNetworkReply::NetworkError networkError() const;
 
     QList<Message> obtainNewMessages(bool* error_during_obtaining);
+    DataChange lastDataChange() const;
 
     // Tries to guess feed hidden under given URL
     // and uses given credentials.
@@ -84,6 +85,12 @@ class StandardFeed : public Feed {
   public slots:
     void fetchMetadataForItself();
 
+  protected:
+    void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
+
+  private:
+    quint64 contentsHash(const QByteArray& feed_contents) const;
+
   private:
     bool m_passwordProtected{};
     QString m_username;
@@ -92,6 +99,22 @@ class StandardFeed : public Feed {
 
     QNetworkReply::NetworkError m_networkError;
     QString m_encoding;
+
+    // HTTP validators (ETag and Last-Modified headers) of last stored feed data,
+    // they are sent with next update so that server can reply with "304 Not Modified".
+    QString m_httpETag;
+    QString m_httpLastModified;
+    QString m_pendingHttpETag;
+    QString m_pendingHttpLastModified;
+    bool m_httpValidatorsChanged;
+
+    // Hash of raw feed data (and of scripts of assigned message filters)
+    // whose messages were stored last time. If new data have the same hash,
+    // they are not parsed again. Hash is stored in DB together with HTTP validators,
+    // zero means that there is no hash.
+    quint64 m_contentsHash;
+    quint64 m_pendingContentsHash;
+    DataChange m_lastDataChange;
 };
 
 Q_DECLARE_METATYPE(StandardFeed::Type)
@@ -107,6 +107,10 @@ bool StandardServiceRoot::supportsCategoryAdding() const {
   return true;
 }
 
+bool StandardServiceRoot::supportsConcurrentFeedUpdates() const {
+  return true;
+}
+
 void StandardServiceRoot::addNewFeed(const QString& url) {
   if (!qApp->feedUpdateLock()->tryLock()) {
     // Lock was not obtained because
@@ -31,6 +31,7 @@ class StandardServiceRoot : public ServiceRoot {
     bool deleteViaGui();
     bool supportsFeedAdding() const;
     bool supportsCategoryAdding() const;
+    bool supportsConcurrentFeedUpdates() const;
 
     Qt::ItemFlags additionalFlags() const;
 
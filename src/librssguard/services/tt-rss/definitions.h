@@ -16,6 +16,15 @@
 // Limitations
 #define TTRSS_MAX_MESSAGES      200
 
+// Interval of complete re-download of feed messages, in hours.
+// Otherwise only messages newer than the newest stored message are downloaded.
+#define TTRSS_FULL_SYNC_INTERVAL  24
+
+// View modes of headlines.
+#define TTRSS_VIEW_MODE_ALL     "all_articles"
+#define TTRSS_VIEW_MODE_UNREAD  "unread"
+#define TTRSS_VIEW_MODE_MARKED  "marked"
+
 // General return status codes.
 #define TTRSS_API_STATUS_OK     0
 #define TTRSS_API_STATUS_ERR    1
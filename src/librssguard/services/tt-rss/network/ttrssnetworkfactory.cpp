@@ -185,7 +185,7 @@ TtRssGetFeedsCategoriesResponse TtRssNetworkFactory::getFeedsCategories() {
 
 TtRssGetHeadlinesResponse TtRssNetworkFactory::getHeadlines(int feed_id, int limit, int skip,
                                                             bool show_content, bool include_attachments,
-                                                            bool sanitize, bool unread_only) {
+                                                            bool sanitize, const QString& view_mode, qint64 since_id) {
   QJsonObject json;
 
   json["op"] = QSL("getHeadlines");
@@ -194,7 +194,12 @@ TtRssGetHeadlinesResponse TtRssNetworkFactory::getHeadlines(int feed_id, int lim
   json["force_update"] = m_forceServerSideUpdate;
   json["limit"] = limit;
   json["skip"] = skip;
-  json["view_mode"] = unread_only ? QSL("unread") : QSL("all_articles");
+  json["view_mode"] = view_mode;
+
+  if (since_id > 0) {
+    json["since_id"] = since_id;
+  }
+
   json["show_content"] = show_content;
   json["include_attachments"] = include_attachments;
   json["sanitize"] = sanitize;
@@ -142,10 +142,11 @@ class TtRssNetworkFactory {
     // Gets feeds from the server.
     TtRssGetFeedsCategoriesResponse getFeedsCategories();
 
-    // Gets headlines (messages) from the server.
+    // Gets headlines (messages) from the server, only headlines
+    // with ID greater than "since_id" are returned if it is set.
     TtRssGetHeadlinesResponse getHeadlines(int feed_id, int limit, int skip,
                                            bool show_content, bool include_attachments,
-                                           bool sanitize, bool unread_only);
+                                           bool sanitize, const QString& view_mode, qint64 since_id = 0);
 
     TtRssUpdateArticleResponse updateArticles(const QStringList& ids, UpdateArticle::OperatingField field,
                                               UpdateArticle::Mode mode, bool async = true);
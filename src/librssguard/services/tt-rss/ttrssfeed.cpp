@@ -14,9 +14,13 @@
 
 #include <QPointer>
 
-TtRssFeed::TtRssFeed(RootItem* parent) : Feed(parent) {}
+TtRssFeed::TtRssFeed(RootItem* parent)
+  : Feed(parent), m_lastArticleId(0), m_pendingFullSync(false),
+  m_pendingStatesSync(false), m_pendingLastArticleId(0) {}
 
-TtRssFeed::TtRssFeed(const QSqlRecord& record) : Feed(record) {}
+TtRssFeed::TtRssFeed(const QSqlRecord& record)
+  : Feed(record), m_lastArticleId(0), m_pendingFullSync(false),
+  m_pendingStatesSync(false), m_pendingLastArticleId(0) {}
 
 TtRssFeed::~TtRssFeed() = default;
 
@@ -68,6 +72,81 @@ bool TtRssFeed::editItself(TtRssFeed* new_feed_data) {
 }
 
 QList<Message> TtRssFeed::obtainNewMessages(bool* error_during_obtaining) {
+  // NOTE: Time of last full synchronization is not persisted,
+  // so first update after start of application is always full.
+  const bool full_sync = m_lastArticleId <= 0 || !m_lastFullSync.isValid() ||
+                         m_lastFullSync.secsTo(QDateTime::currentDateTimeUtc()) > TTRSS_FULL_SYNC_INTERVAL * 3600;
+  const QString view_mode = serviceRoot()->network()->downloadOnlyUnreadMessages()
+                            ? QSL(TTRSS_VIEW_MODE_UNREAD)
+                            : QSL(TTRSS_VIEW_MODE_ALL);
+  bool ok;
+  QList<Message> messages = obtainHeadlines(view_mode, true, full_sync ? 0 : m_lastArticleId, &ok);
+
+  m_pendingUnreadIds.clear();
+  m_pendingImportantIds.clear();
+
+  if (ok && !full_sync) {
+    // Only new articles were downloaded, so states of older articles
+    // are obtained separately, without their contents.
+    for (const Message& msg : obtainHeadlines(QSL(TTRSS_VIEW_MODE_UNREAD), false, 0, &ok)) {
+      m_pendingUnreadIds.insert(msg.m_customId);
+    }
+
+    if (ok) {
+      for (const Message& msg : obtainHeadlines(QSL(TTRSS_VIEW_MODE_MARKED), false, 0, &ok)) {
+        m_pendingImportantIds.insert(msg.m_customId);
+      }
+    }
+  }
+
+  if (!ok) {
+    setStatus(Feed::NetworkError);
+    *error_during_obtaining = true;
+    serviceRoot()->itemChanged(QList<RootItem*>() << this);
+    return QList<Message>();
+  }
+
+  qDebug("TT-RSS: Obtained %d messages of feed '%s' using %s synchronization.",
+         messages.size(), qPrintable(customId()), full_sync ? "full" : "incremental");
+
+  m_pendingFullSync = full_sync;
+  m_pendingStatesSync = !full_sync;
+  m_pendingLastArticleId = m_lastArticleId;
+
+  for (const Message& msg : messages) {
+    m_pendingLastArticleId = qMax(m_pendingLastArticleId, msg.m_customId.toLongLong());
+  }
+
+  *error_during_obtaining = false;
+  return messages;
+}
+
+qint64 TtRssFeed::lastArticleId() const {
+  return m_lastArticleId;
+}
+
+void TtRssFeed::setLastArticleId(qint64 last_article_id) {
+  m_lastArticleId = last_article_id;
+}
+
+void TtRssFeed::onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta) {
+  if (m_pendingStatesSync &&
+      !DatabaseQueries::updateMessageStatesOfFeed(db, customId(), serviceRoot()->accountId(),
+                                                  m_pendingUnreadIds, m_pendingImportantIds, &counts_delta)) {
+    qWarning("TT-RSS: Failed to synchronize states of messages of feed '%s'.", qPrintable(customId()));
+  }
+
+  if (m_pendingFullSync) {
+    m_lastFullSync = QDateTime::currentDateTimeUtc();
+  }
+
+  m_lastArticleId = m_pendingLastArticleId;
+  m_pendingStatesSync = m_pendingFullSync = false;
+  m_pendingUnreadIds.clear();
+  m_pendingImportantIds.clear();
+}
+
+QList<Message> TtRssFeed::obtainHeadlines(const QString& view_mode, bool show_content, qint64 since_id, bool* ok) const {
   QList<Message> messages;
   int newly_added_messages = 0;
   int limit = TTRSS_MAX_MESSAGES;
@@ -75,13 +154,11 @@ QList<Message> TtRssFeed::obtainNewMessages(bool* error_during_obtaining) {
 
   do {
     TtRssGetHeadlinesResponse headlines = serviceRoot()->network()->getHeadlines(customId().toInt(), limit, skip,
-                                                                                 true, true, false,
-                                                                                 serviceRoot()->network()->downloadOnlyUnreadMessages());
+                                                                                 show_content, show_content, false,
+                                                                                 view_mode, since_id);
 
     if (serviceRoot()->network()->lastError() != QNetworkReply::NoError) {
-      setStatus(Feed::NetworkError);
-      *error_during_obtaining = true;
-      serviceRoot()->itemChanged(QList<RootItem*>() << this);
+      *ok = false;
       return QList<Message>();
     }
     else {
@@ -94,7 +171,7 @@ QList<Message> TtRssFeed::obtainNewMessages(bool* error_during_obtaining) {
   }
   while (newly_added_messages > 0);
 
-  *error_during_obtaining = false;
+  *ok = true;
   return messages;
 }
 
@@ -5,6 +5,8 @@
 
 #include "services/abstract/feed.h"
 
+#include <QDateTime>
+#include <QSet>
 #include <QSqlRecord>
 
 class TtRssServiceRoot;
@@ -28,6 +30,29 @@ class TtRssFeed : public Feed {
     bool removeItself();
 
     QList<Message> obtainNewMessages(bool* error_during_obtaining);
+
+    qint64 lastArticleId() const;
+    void setLastArticleId(qint64 last_article_id);
+
+  protected:
+    void onAfterMessagesStored(const QSqlDatabase& db, MessageCountsDelta& counts_delta);
+
+  private:
+    QList<Message> obtainHeadlines(const QString& view_mode, bool show_content, qint64 since_id, bool* ok) const;
+
+  private:
+
+    // ID of newest article of this feed stored in DB, newer articles are
+    // downloaded incrementally unless full synchronization is due.
+    qint64 m_lastArticleId;
+    QDateTime m_lastFullSync;
+
+    // Results of last download, which are applied after messages are stored.
+    bool m_pendingFullSync;
+    bool m_pendingStatesSync;
+    qint64 m_pendingLastArticleId;
+    QSet<QString> m_pendingUnreadIds;
+    QSet<QString> m_pendingImportantIds;
 };
 
 #endif // TTRSSFEED_H
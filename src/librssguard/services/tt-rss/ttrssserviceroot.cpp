@@ -111,41 +111,22 @@ bool TtRssServiceRoot::canBeDeleted() const {
   return true;
 }
 
-void TtRssServiceRoot::saveAllCachedData(bool async) {
-  QPair<QMap<RootItem::ReadStatus, QStringList>, QMap<RootItem::Importance, QList<Message>>> msgCache = takeMessageCache();
-  QMapIterator<RootItem::ReadStatus, QStringList> i(msgCache.first);
-
-  // Save the actual data read/unread.
-  while (i.hasNext()) {
-    i.next();
-    auto key = i.key();
-    QStringList ids = i.value();
-
-    if (!ids.isEmpty()) {
-      network()->updateArticles(ids,
-                                UpdateArticle::Unread,
-                                key == RootItem::Unread ? UpdateArticle::SetToTrue : UpdateArticle::SetToFalse,
-                                async);
-    }
-  }
-
-  QMapIterator<RootItem::Importance, QList<Message>> j(msgCache.second);
-
-  // Save the actual data important/not important.
-  while (j.hasNext()) {
-    j.next();
-    auto key = j.key();
-    QList<Message> messages = j.value();
-
-    if (!messages.isEmpty()) {
-      QStringList ids = customIDsOfMessages(messages);
+QNetworkReply::NetworkError TtRssServiceRoot::sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids,
+                                                                    bool async) {
+  network()->updateArticles(custom_ids,
+                            UpdateArticle::Unread,
+                            read == RootItem::Unread ? UpdateArticle::SetToTrue : UpdateArticle::SetToFalse,
+                            async);
+  return network()->lastError();
+}
 
-      network()->updateArticles(ids,
-                                UpdateArticle::Starred,
-                                key == RootItem::Important ? UpdateArticle::SetToTrue : UpdateArticle::SetToFalse,
-                                async);
-    }
-  }
+QNetworkReply::NetworkError TtRssServiceRoot::sendMessageImportances(RootItem::Importance importance,
+                                                                     const QList<Message>& messages, bool async) {
+  network()->updateArticles(customIDsOfMessages(messages),
+                            UpdateArticle::Starred,
+                            importance == RootItem::Important ? UpdateArticle::SetToTrue : UpdateArticle::SetToFalse,
+                            async);
+  return network()->lastError();
 }
 
 QList<QAction*> TtRssServiceRoot::serviceMenu() {
@@ -217,6 +198,13 @@ void TtRssServiceRoot::loadFromDatabase() {
   appendChild(recycleBin());
   appendChild(importantNode());
   updateCounts(true);
+
+  // Feeds with already stored messages are updated incrementally.
+  const QHash<QString, qint64> last_article_ids = DatabaseQueries::lastCustomIdsOfMessagesInFeeds(database, accountId());
+
+  for (Feed* feed : getSubTreeFeeds()) {
+    static_cast<TtRssFeed*>(feed)->setLastArticleId(last_article_ids.value(feed->customId()));
+  }
 }
 
 void TtRssServiceRoot::updateTitle() {
@@ -32,8 +32,6 @@ class TtRssServiceRoot : public ServiceRoot, public CacheForServiceRoot {
 
     QString additionalTooltip() const;
 
-    void saveAllCachedData(bool async = true);
-
     // Access to network.
     TtRssNetworkFactory* network() const;
 
@@ -44,6 +42,11 @@ class TtRssServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     void addNewFeed(const QString& url = QString());
     void addNewCategory();
 
+  protected:
+    QNetworkReply::NetworkError sendMessageReadStates(RootItem::ReadStatus read, const QStringList& custom_ids, bool async);
+    QNetworkReply::NetworkError sendMessageImportances(RootItem::Importance importance, const QList<Message>& messages,
+                                                       bool async);
+
   private:
     RootItem* obtainNewTreeForSyncIn() const;
 
@@ -0,0 +1,23 @@
+TEMPLATE = app
+TARGET = tst_databasequeries
+
+MSG_PREFIX = "tst_databasequeries"
+APP_TYPE = "unit test"
+
+include(../../pri/vars.pri)
+include(../../pri/defs.pri)
+include(../../pri/build_opts.pri)
+
+QT *= testlib
+CONFIG *= testcase
+
+DEFINES *= RSSGUARD_DLLSPEC=Q_DECL_IMPORT
+SOURCES += tst_databasequeries.cpp
+INCLUDEPATH +=  $$PWD/../../src/librssguard \
+                $$OUT_PWD/../../src/librssguard \
+                $$OUT_PWD/../../src/librssguard/ui
+
+DEPENDPATH += $$PWD/../../src/librssguard
+
+win32: LIBS += -L$$OUT_PWD/../../src/librssguard/ -llibrssguard
+unix: LIBS += -L$$OUT_PWD/../../src/librssguard/ -lrssguard
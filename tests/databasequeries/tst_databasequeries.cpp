@@ -0,0 +1,85 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "miscellaneous/databasequeries.h"
+
+#include "definitions/definitions.h"
+
+#include <QtTest>
+
+static Message urlMessage(const QString& title, const QString& url, const QString& author, const QString& contents) {
+  Message msg;
+
+  msg.m_title = title;
+  msg.m_url = url;
+  msg.m_author = author;
+  msg.m_contents = contents;
+  return msg;
+}
+
+static Message idMessage(const QString& custom_id, const QString& contents) {
+  Message msg;
+
+  msg.m_customId = custom_id;
+  msg.m_contents = contents;
+  return msg;
+}
+
+static QStringList contentsOf(const QList<Message>& messages) {
+  QStringList contents;
+
+  for (const Message& msg : messages) {
+    contents.append(msg.m_contents);
+  }
+
+  return contents;
+}
+
+class TestDatabaseQueries : public QObject {
+  Q_OBJECT
+
+  private slots:
+    void firstOccurrenceOfMessageIsKept();
+    void messagesDifferingInCaseAreKeptForSqlite();
+    void messagesDifferingInCaseAreDroppedForMysql();
+};
+
+void TestDatabaseQueries::firstOccurrenceOfMessageIsKept() {
+  const QList<Message> messages = {
+    urlMessage(QSL("t"), QSL("http://a"), QSL("x"), QSL("1")),
+    idMessage(QSL("id"), QSL("2")),
+    urlMessage(QSL("t"), QSL("http://a"), QSL("x"), QSL("3")),
+    urlMessage(QSL("t"), QSL("http://a"), QSL("y"), QSL("4")),
+    idMessage(QSL("id"), QSL("5"))
+  };
+
+  QCOMPARE(contentsOf(DatabaseQueries::uniqueMessages(messages, false)),
+           QStringList() << QSL("1") << QSL("2") << QSL("4"));
+}
+
+void TestDatabaseQueries::messagesDifferingInCaseAreKeptForSqlite() {
+  const QList<Message> messages = {
+    urlMessage(QSL("Title"), QSL("http://a"), QSL("x"), QSL("1")),
+    urlMessage(QSL("title"), QSL("http://a"), QSL("x"), QSL("2")),
+    idMessage(QSL("ID"), QSL("3")),
+    idMessage(QSL("id"), QSL("4"))
+  };
+
+  QCOMPARE(contentsOf(DatabaseQueries::uniqueMessages(messages, false)),
+           QStringList() << QSL("1") << QSL("2") << QSL("3") << QSL("4"));
+}
+
+void TestDatabaseQueries::messagesDifferingInCaseAreDroppedForMysql() {
+  const QList<Message> messages = {
+    urlMessage(QSL("Title"), QSL("http://a"), QSL("x"), QSL("1")),
+    urlMessage(QSL("title"), QSL("HTTP://A"), QSL("X"), QSL("2")),
+    idMessage(QSL("ID"), QSL("3")),
+    idMessage(QSL("id"), QSL("4"))
+  };
+
+  QCOMPARE(contentsOf(DatabaseQueries::uniqueMessages(messages, true)),
+           QStringList() << QSL("1") << QSL("3"));
+}
+
+QTEST_GUILESS_MAIN(TestDatabaseQueries)
+
+#include "tst_databasequeries.moc"
@@ -0,0 +1,169 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "services/abstract/syncforserviceroot.h"
+
+#include "definitions/definitions.h"
+
+#include <QtTest>
+
+// Account with messages kept in memory. Each message has time of its arrival,
+// which is used as cursor in the same way as Inoreader reading list uses it.
+class TestSyncRoot : public SyncForServiceRoot {
+  public:
+    void addServerMessage(const QString& feed_custom_id, const QString& custom_id, qint64 arrival) {
+      Message msg;
+
+      msg.m_feedId = feed_custom_id;
+      msg.m_customId = custom_id;
+      m_serverMessages.append(QPair<Message, qint64>(msg, arrival));
+    }
+
+    QStringList takeIds(const QString& feed_custom_id) {
+      Feed::Status error = Feed::Status::Normal;
+      QStringList ids;
+
+      for (const Message& msg : takeSyncedMessages(feed_custom_id, error)) {
+        ids.append(msg.m_customId);
+      }
+
+      return ids;
+    }
+
+    void stored(const QString& feed_custom_id) {
+      onAfterSyncedMessagesStored(QSqlDatabase(), feed_custom_id);
+    }
+
+    qint64 m_storedCursor = 0;
+    int m_accountDownloads = 0;
+    int m_feedDownloads = 0;
+
+  protected:
+    Feed::Status downloadSyncedMessages(qint64 cursor, const QStringList& feed_custom_ids,
+                                        QList<Message>& messages, qint64& new_cursor) {
+      Q_UNUSED(feed_custom_ids)
+
+      // Like reading list, messages of whole account are returned.
+      m_accountDownloads++;
+
+      for (const auto& msg : m_serverMessages) {
+        if (msg.second > cursor) {
+          messages.append(msg.first);
+          new_cursor = qMax(new_cursor, msg.second);
+        }
+      }
+
+      return Feed::Status::Normal;
+    }
+
+    Feed::Status downloadFeedMessages(const QString& feed_custom_id, QList<Message>& messages) {
+      m_feedDownloads++;
+
+      for (const auto& msg : m_serverMessages) {
+        if (msg.first.m_feedId == feed_custom_id) {
+          messages.append(msg.first);
+        }
+      }
+
+      return Feed::Status::Normal;
+    }
+
+    bool storeSyncCursor(const QSqlDatabase& db, qint64 cursor) {
+      Q_UNUSED(db)
+
+      m_storedCursor = cursor;
+      return true;
+    }
+
+  private:
+    QList<QPair<Message, qint64>> m_serverMessages;
+};
+
+class TestSyncForServiceRoot : public QObject {
+  Q_OBJECT
+
+  private slots:
+    void wholeAccountUpdateStoresCursor();
+    void partialUpdateDoesNotLoseMessages();
+    void unfinishedUpdateIsDownloadedAgain();
+};
+
+void TestSyncForServiceRoot::wholeAccountUpdateStoresCursor() {
+  const QStringList feeds = { QSL("a"), QSL("b") };
+  TestSyncRoot root;
+
+  root.setSyncCursor(10);
+  root.addServerMessage(QSL("a"), QSL("a-old"), 5);
+  root.addServerMessage(QSL("a"), QSL("a-1"), 20);
+  root.addServerMessage(QSL("b"), QSL("b-1"), 30);
+
+  root.startSync(feeds, feeds);
+  QCOMPARE(root.takeIds(QSL("a")), QStringList() << QSL("a-1"));
+  root.stored(QSL("a"));
+
+  // Cursor is stored only after all feeds of the update are stored.
+  QCOMPARE(root.m_storedCursor, qint64(0));
+  QCOMPARE(root.takeIds(QSL("b")), QStringList() << QSL("b-1"));
+  root.stored(QSL("b"));
+
+  QCOMPARE(root.m_accountDownloads, 1);
+  QCOMPARE(root.m_feedDownloads, 0);
+  QCOMPARE(root.m_storedCursor, qint64(30));
+}
+
+void TestSyncForServiceRoot::partialUpdateDoesNotLoseMessages() {
+  const QStringList feeds = { QSL("a"), QSL("b") };
+  TestSyncRoot root;
+
+  root.setSyncCursor(10);
+  root.addServerMessage(QSL("a"), QSL("a-1"), 20);
+  root.addServerMessage(QSL("b"), QSL("b-1"), 30);
+
+  // Only feed "a" is updated, its messages are downloaded separately.
+  root.startSync(QStringList() << QSL("a"), feeds);
+  QCOMPARE(root.takeIds(QSL("a")), QStringList() << QSL("a-1"));
+  root.stored(QSL("a"));
+
+  QCOMPARE(root.m_accountDownloads, 0);
+  QCOMPARE(root.m_feedDownloads, 1);
+  QCOMPARE(root.syncCursor(), qint64(10));
+  QCOMPARE(root.m_storedCursor, qint64(0));
+
+  // Messages of feed "b" were not skipped by the cursor.
+  root.startSync(feeds, feeds);
+  QCOMPARE(root.takeIds(QSL("b")), QStringList() << QSL("b-1"));
+  root.stored(QSL("b"));
+  QCOMPARE(root.takeIds(QSL("a")), QStringList() << QSL("a-1"));
+  root.stored(QSL("a"));
+
+  QCOMPARE(root.m_accountDownloads, 1);
+  QCOMPARE(root.m_storedCursor, qint64(30));
+}
+
+void TestSyncForServiceRoot::unfinishedUpdateIsDownloadedAgain() {
+  const QStringList feeds = { QSL("a"), QSL("b") };
+  TestSyncRoot root;
+
+  root.setSyncCursor(10);
+  root.addServerMessage(QSL("a"), QSL("a-1"), 20);
+  root.addServerMessage(QSL("b"), QSL("b-1"), 30);
+
+  // Update is stopped before feed "b" takes its messages.
+  root.startSync(feeds, feeds);
+  QCOMPARE(root.takeIds(QSL("a")), QStringList() << QSL("a-1"));
+  root.stored(QSL("a"));
+  QCOMPARE(root.m_storedCursor, qint64(0));
+
+  root.startSync(feeds, feeds);
+  QCOMPARE(root.syncCursor(), qint64(10));
+  QCOMPARE(root.takeIds(QSL("b")), QStringList() << QSL("b-1"));
+  root.stored(QSL("b"));
+  QCOMPARE(root.takeIds(QSL("a")), QStringList() << QSL("a-1"));
+  root.stored(QSL("a"));
+
+  QCOMPARE(root.m_accountDownloads, 2);
+  QCOMPARE(root.m_storedCursor, qint64(30));
+}
+
+QTEST_GUILESS_MAIN(TestSyncForServiceRoot)
+
+#include "tst_syncforserviceroot.moc"